@@ -7,4 +7,5 @@
 
 #define LOG_TO_FILE_ONLY 0
 #define LOG_TO_TERMINAL_ONLY 1
-#define LOG_TO_FILE_AND_TERMINAL 2
\ No newline at end of file
+#define LOG_TO_FILE_AND_TERMINAL 2
+#define LOG_TO_NONE 3
\ No newline at end of file
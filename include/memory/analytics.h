@@ -0,0 +1,65 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "memory_manager.h"
+
+#define ANALYTICS_DEFAULT_WINDOW 1000  // Accesses in a process's working-set window
+#define ANALYTICS_DISTANCE_BUCKETS 40  // Bucket 0: distance 0; bucket b: distances in [2^(b-1), 2^b)
+#define ANALYTICS_INITIAL_CAPACITY 1024
+
+// Page of a process and where its last access sits in the process's access tree
+typedef struct
+{
+    size_t vpage;
+    size_t index;
+    bool used;
+} AnalyticsPage;
+
+// Access history of one process. Every page's last access is marked in a Fenwick tree indexed by
+// access order, so the number of distinct pages touched since any earlier access is a range sum:
+// that gives the reuse (LRU stack) distance and the working-set size in O(log n)
+typedef struct
+{
+    int processId;           // -1: slot unused
+    uint64_t time;           // Accesses so far (the process's virtual time)
+    uint32_t *tree;          // Fenwick tree over access indices: 1 where a page's last access sits
+    uint64_t *indexTime;     // Virtual time of the access each index was handed to (ascending)
+    size_t nextIndex;
+    size_t treeCapacity;
+    AnalyticsPage *pages;    // Open-addressing table of the pages seen
+    size_t pageCount;
+    size_t pageCapacity;
+
+    size_t distanceBuckets[ANALYTICS_DISTANCE_BUCKETS];
+    size_t coldAccesses;     // First touches of a page (infinite reuse distance)
+    size_t workingSet;       // Distinct pages in the last window accesses
+    size_t peakWorkingSet;
+    uint64_t workingSetSum;  // Sum over accesses, for the average
+} ProcessAnalytics;
+
+// Per-process working-set and reuse-distance tracking; attach through manager->analytics to be
+// fed every accessPage and translateAddress call
+typedef struct AccessAnalytics
+{
+    size_t window;
+    ProcessAnalytics *processes; // Indexed by process table slot
+    int processCapacity;
+} AccessAnalytics;
+
+// Analytics lifecycle
+AccessAnalytics *createAccessAnalytics(size_t window);
+void destroyAccessAnalytics(AccessAnalytics *analytics);
+
+// Called by the memory manager for every resolved page access
+void analyticsRecordAccess(AccessAnalytics *analytics, int processId, size_t vpage);
+
+// Queries (a terminated process's history stays until its slot is reused)
+ProcessAnalytics *getProcessAnalytics(AccessAnalytics *analytics, int processId);
+size_t reuseDistancePercentile(const ProcessAnalytics *process, double percentile);
+size_t suggestFrameQuota(const ProcessAnalytics *process, double hitRatio);
+void printAccessAnalytics(AccessAnalytics *analytics);
+
+#endif // ANALYTICS_H
@@ -3,55 +3,221 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+
+// Segregated free-list index: bin i holds free segments with sizes in [2^i, 2^(i+1))
+#define SEGMENT_BIN_COUNT 64
+#define SEGMENT_BIN_PROBE_LIMIT 8 // Entries probed in the request's own bin for an exact fit
+
+// Owner ID recorded on page frames held by slab caches rather than a process
+#define SLAB_PROCESS_ID -2
+
+// Owner ID recorded on copy-on-write frames still shared after the process that first mapped them let go
+#define SHARED_PROCESS_ID -3
+
+// Process ids pack a table slot with the slot's generation, so an id held past terminateProcess
+// no longer matches once the slot is recycled
+#define PROCESS_SLOT_BITS 20
+#define PROCESS_MAX_SLOTS (1 << PROCESS_SLOT_BITS)
+#define PROCESS_GENERATION_MASK 0x7FF // 11 bits keep ids positive in an int
+#define PROCESS_SLOT(id) ((id) & (PROCESS_MAX_SLOTS - 1))
+#define PROCESS_TABLE_INITIAL_SLOTS 16
+
+// Segment nodes carved per pool chunk
+#define SEGMENT_POOL_CHUNK_NODES 256
+
+// Snapshot file identity; the version changes whenever the record layout does
+#define SNAPSHOT_MAGIC "MMSNAPSH"
+#define SNAPSHOT_VERSION 1
+
+// Segments an incremental compaction step may visit before yielding
+#define COMPACTION_STEP_MAX_SEGMENTS 64
+
+// Radix page tables shaped like x86-64: 4 levels of 512 slots over a 36-bit virtual page number
+#define PAGE_TABLE_LEVELS 4
+#define PAGE_TABLE_BITS 9
+#define PAGE_TABLE_FANOUT (1 << PAGE_TABLE_BITS)
+#define PAGE_TABLE_MAX_VPAGES ((size_t)1 << (PAGE_TABLE_LEVELS * PAGE_TABLE_BITS))
+
+// Buddy allocator limits
+#define BUDDY_MAX_ORDERS 48
+#define BUDDY_DEFAULT_MIN_BLOCK 64 // Order-0 block size when no page size is given
+
+// TLSF (two-level segregated fit) parameters
+#define TLSF_SL_LOG2 4                              // log2 of second-level lists per first-level class
+#define TLSF_SL_COUNT (1 << TLSF_SL_LOG2)
+#define TLSF_ALIGN_LOG2 3                           // Block sizes are multiples of 8 bytes
+#define TLSF_FL_SHIFT (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_SMALL_BLOCK (1 << TLSF_FL_SHIFT)       // Sizes below this share first-level class 0
+#define TLSF_FL_COUNT (64 - TLSF_FL_SHIFT + 1)
+#define TLSF_MIN_BLOCK 16                           // Smallest block left behind by a split
 
 // Memory allocation strategies
 typedef enum
 {
     SEGMENTATION,
     PAGING,
-    HYBRID // A combination of both
+    HYBRID, // A combination of both
+    BUDDY,  // Binary buddy system over power-of-two blocks
+    TLSF    // Two-level segregated fit with O(1) allocation and free
 } MemoryStrategy;
 
+// Placement policies for choosing a free segment
+typedef enum
+{
+    PLACEMENT_FIRST_FIT,     // Lowest-address hole that fits
+    PLACEMENT_NEXT_FIT,      // First fit, resuming from the last allocation (roving pointer)
+    PLACEMENT_BEST_FIT,      // Smallest hole that fits
+    PLACEMENT_WORST_FIT,     // Largest hole
+    PLACEMENT_SEGREGATED_FIT // Size-class bins with an exact-fit path
+} PlacementPolicy;
+
 // Memory block structure for segmentation
 typedef struct MemorySegment
 {
     int id;                     // Segment ID
     size_t size;                // Size of the segment
     size_t address;             // Starting address
+    size_t usedBytes;           // Bytes actually requested (less than size for rounded blocks)
     bool allocated;             // Whether this segment is allocated
     char processName[32];       // Name of the process that owns this segment
     int processId;              // ID of the process that owns this segment
     char segmentType[16];       // Type: "code", "data", "stack", etc.
     struct MemorySegment *next; // Linked list implementation
+    struct MemorySegment *prev; // Previous segment in address order
+
+    // Free-list index links (only meaningful while the segment is free)
+    struct MemorySegment *nextFree;
+    struct MemorySegment *prevFree;
+
+    // Size-ordered tree links (treap keyed by size, then address) over free segments
+    struct MemorySegment *treeLeft;
+    struct MemorySegment *treeRight;
+
+    // Next segment owned by the same process (only meaningful while allocated)
+    struct MemorySegment *nextInProcess;
+
+    // Position in the manager's largest-free-block heap (only meaningful while free)
+    size_t heapIndex;
 } MemorySegment;
 
-// Page structure for paging
-typedef struct
+struct Slab;
+struct Tlb;
+struct TraceWriter;
+struct SwapDevice;
+struct AccessAnalytics;
+
+// Chunk of segment nodes owned by a manager's node pool
+typedef struct SegmentChunk
 {
-    int id;             // Page ID
+    struct SegmentChunk *next;
+    MemorySegment nodes[SEGMENT_POOL_CHUNK_NODES];
+} SegmentChunk;
+
+// Page replacement policies for demand paging
+typedef enum
+{
+    REPLACEMENT_FIFO,  // Evict the page that was faulted in first
+    REPLACEMENT_LRU,   // Evict the least recently accessed page
+    REPLACEMENT_CLOCK, // Second chance: skip (and clear) recently referenced pages in FIFO order
+    REPLACEMENT_ARC    // Adaptive replacement cache balancing recency (T1) and frequency (T2)
+} ReplacementPolicy;
+
+// Lists a page table entry can sit on under demand paging
+typedef enum
+{
+    RESIDENCY_NONE,
+    RESIDENCY_T1, // Resident pages (the only list used by FIFO, LRU and Clock)
+    RESIDENCY_T2, // ARC: resident pages accessed more than once
+    RESIDENCY_B1, // ARC: ghosts of pages evicted from T1
+    RESIDENCY_B2, // ARC: ghosts of pages evicted from T2
+    RESIDENCY_LIST_COUNT
+} ResidencyList;
+
+// Page structure for paging (used both for physical frames and page table entries)
+typedef struct Page
+{
+    size_t id;          // Page ID (the virtual page number in a page table)
     size_t frameNumber; // Frame number in physical memory
-    bool allocated;     // Whether this page is allocated
+    bool allocated;     // Frames: in use; page table entries: resident in frameNumber
     int processId;      // Process ID that owns this page
     size_t usedBytes;   // How much of the page is actually used
+    struct Slab *slab;  // Slab carved from this frame (processId == SLAB_PROCESS_ID)
+    bool huge;          // Part of a huge page: one of hugePageSize / pageSize aligned frames mapped together
+    int refCount;       // Frames: page table entries mapping this frame (more than one once shared by forkProcess)
+    bool readOnly;      // Entries: shared copy-on-write, so the first write copies the frame
+
+    // Demand paging state (page table entries only)
+    bool dirty;             // Written since it was faulted in
+    bool referenced;        // Accessed since Clock last passed over it
+    ResidencyList residency;
+    struct Page *listPrev;  // Neighbours on the residency list, oldest first
+    struct Page *listNext;
+    long swapSlot;          // Slot holding the contents on manager->swap (SWAP_NO_SLOT, SWAP_SLOT_PENDING)
+    bool prefetched;        // Read ahead from swap and not accessed since
 } Page;
 
-// Page table structure
+// Interior node of a radix page table; the lowest interior level points at leaf tables of
+// PAGE_TABLE_FANOUT Page entries
+typedef struct PageTableNode
+{
+    void *children[PAGE_TABLE_FANOUT];
+} PageTableNode;
+
+// Page table structure: a PAGE_TABLE_LEVELS-level radix tree over virtual page numbers
+// with interior nodes and leaf tables allocated on first use (leaf entries with processId -1 are unmapped)
 typedef struct
 {
     int processId;
-    Page *pages;
-    int pageCount;
+    PageTableNode *root;
+    int pageCount;     // Mapped virtual pages
+    size_t topPage;    // One past the highest mapped virtual page (batch allocations grow from here)
+    size_t nodeCount;  // Interior nodes allocated
+    size_t leafCount;  // Leaf tables allocated
 } PageTable;
 
+// Demand paging counters
+typedef struct
+{
+    size_t accesses;       // accessPage calls on valid pages
+    size_t hits;           // Accesses to resident pages
+    size_t faults;         // Accesses that had to fault a page in
+    size_t evictions;      // Resident pages evicted to make room
+    size_t dirtyEvictions; // Evicted pages that had been written (would need writeback)
+    size_t failedFaults;   // Faults with no free frame and nothing evictable
+} PagingStats;
+
+// Copy-on-write counters for forked processes
+typedef struct
+{
+    size_t forks;
+    size_t sharedPages;     // Entries mapping a frame another entry also maps (frames an eager copy would have taken)
+    size_t peakSharedPages;
+    size_t cowFaults;       // Writes that copied a shared frame
+    size_t pagesCopied;     // Frames copied by those writes (a huge page is copied whole)
+    size_t cowReuses;       // Writes to a read-only page whose frame was no longer shared, so nothing was copied
+    size_t failedCopies;    // Copy-on-write faults with no free frame to copy into
+} CowStats;
+
+// Process table slot states
+typedef enum
+{
+    PROCESS_FREE,     // Slot is on the free-slot stack
+    PROCESS_STARTING, // createProcess is making the initial allocation
+    PROCESS_RUNNING
+} ProcessState;
+
 // Process structure
 typedef struct
 {
     int id;
+    ProcessState state;
+    unsigned int generation; // Bumped each time the slot is released
     char name[32];
     size_t size;
     MemoryStrategy allocStrategy;
 
-    // For segmentation
+    // For segmentation: owned segments, chained through nextInProcess
     MemorySegment *segments;
     int segmentCount;
 
@@ -68,42 +234,204 @@ typedef struct
     size_t freeMemory;
     size_t usedMemory;
 
+    // Pool for every MemorySegment node (free nodes are chained through next)
+    SegmentChunk *segmentChunks;
+    MemorySegment *freeSegmentNodes;
+
     // For segmentation
+    PlacementPolicy placement;
     MemorySegment *segmentList;
+    MemorySegment *freeTree;      // Free segments ordered by size for best-fit/worst-fit
+    MemorySegment *nextFitCursor; // Roving pointer for next-fit
+    MemorySegment *compactCursor; // Where the next incremental compaction step resumes (NULL: list head)
+    bool compactOnFailure;        // Compact and retry when no single hole fits a request
+    MemorySegment *freeBins[SEGMENT_BIN_COUNT]; // Size-class segregated free lists
+    uint64_t freeBinMap;                        // Bit i set when freeBins[i] is non-empty
+
+    // For buddy allocation (blocks live in segmentList, free blocks in per-order lists)
+    size_t buddyMinBlock;                             // Size of an order-0 block
+    int buddyMaxOrder;                                // Largest block order
+    MemorySegment *buddyFreeLists[BUDDY_MAX_ORDERS];  // Free blocks of each order
+    uint64_t buddyOrderMap;                           // Bit k set when buddyFreeLists[k] is non-empty
+    uint64_t *buddyFreeBitmap[BUDDY_MAX_ORDERS];      // Bit i of order k set when block i of that order is free
+    MemorySegment **buddyBlockTable;                  // Block head descriptor, indexed by address / buddyMinBlock
+
+    // For TLSF (blocks live in segmentList, free blocks in two-level segregated lists)
+    uint64_t tlsfFlBitmap;                                    // Bit f set when first-level class f has free blocks
+    uint32_t tlsfSlBitmap[TLSF_FL_COUNT];                     // Bit s set when list [f][s] is non-empty
+    MemorySegment *tlsfFreeLists[TLSF_FL_COUNT][TLSF_SL_COUNT]; // Free blocks by size class
 
     // For paging
     size_t pageSize;
     size_t totalPages;
     size_t freePages;
     Page *pageFrames;
+    uint64_t *frameBitmap; // Bit i set when frame i is allocated (mirrors pageFrames)
+
+    // Huge pages (hugePageSize 0: disabled); a huge page is an aligned run of base frames mapped together
+    size_t hugePageSize;
+    size_t hugePagesAllocated;
+    size_t hugeFrameUsedBytes; // Bytes in use across huge page frames (included in frameUsedBytes)
+
+    // For demand paging (page tables may exceed physical memory; pages are faulted in by accessPage)
+    bool demandPaging;
+    ReplacementPolicy replacement;
+    Page *residencyHead[RESIDENCY_LIST_COUNT]; // Oldest / least recently used entry of each list
+    Page *residencyTail[RESIDENCY_LIST_COUNT];
+    size_t residencySize[RESIDENCY_LIST_COUNT];
+    size_t arcTarget; // ARC's adaptive target size for T1
+    PagingStats pagingStats;
+
+    // Copy-on-write sharing between forked processes
+    CowStats cowStats;
+
+    // Optional TLB consulted by accessPage and translateAddress (owned by the caller)
+    struct Tlb *tlb;
+
+    // Optional swap device that evicted pages are written to and faulted back from (owned by the caller)
+    struct SwapDevice *swap;
 
-    // Process management
+    // Optional working-set and reuse-distance tracking fed by accessPage and translateAddress (owned by the caller)
+    struct AccessAnalytics *analytics;
+
+    // Optional trace recorder for create/allocate/terminate/access calls (owned by the caller)
+    struct TraceWriter *trace;
+
+    // Process management (the table grows on demand; released slots are reused from a stack)
     Process *processes;
-    int processCount;
-    int maxProcesses;
+    int processCount;       // Live processes
+    int maxProcesses;       // Limit on live processes
+    int processSlots;       // Slots ever handed out (high-water mark of the table)
+    int processCapacity;    // Slots allocated in processes
+    int *freeProcessSlots;  // Stack of released slots
+    int freeProcessSlotCount;
+
+    // Running fragmentation counters, updated on every alloc, free, split and merge
+    size_t freeBlockBytes;                // Bytes in free segments/blocks
+    int freeBlockCount;                   // Number of free segments/blocks
+    MemorySegment **freeBlockHeap;        // Max-heap of free segments/blocks by size
+    size_t freeBlockHeapCapacity;         // Grows with the node pool
+    size_t allocatedBlockBytes;           // Bytes in allocated segments/blocks
+    size_t wastedBlockBytes;              // Allocated block bytes beyond the requested sizes
+    size_t frameUsedBytes;                // Bytes in use across allocated page frames
 
     // Statistics
     double externalFragmentation;
     double internalFragmentation;
 } MemoryManager;
 
+// Outcome of a compaction pass
+typedef struct
+{
+    int segmentsMoved;
+    size_t bytesMoved;
+    double elapsedMs;
+    bool complete; // The pass reached the end of memory (all holes merged into one)
+} CompactionResult;
+
+// One request of a batch allocation
+typedef struct
+{
+    int processId;
+    size_t size;
+} AllocationRequest;
+
+// Snapshot of the fragmentation counters
+typedef struct
+{
+    size_t freeBlockBytes;
+    int freeBlockCount;
+    size_t largestFreeBlock;
+    size_t allocatedBlockBytes;
+    size_t wastedBlockBytes;
+    size_t allocatedFrameBytes;
+    size_t wastedFrameBytes;
+    double externalFragmentation; // 1 - largest free block / free block bytes
+    double internalFragmentation; // Wasted bytes / allocated bytes (frames for paging, blocks for buddy/TLSF)
+} FragmentationStats;
+
+// Fragmentation and usage for one page size
+typedef struct
+{
+    size_t pageSize;
+    size_t pagesAllocated;
+    size_t freePages;             // Pages of this size that could still be allocated (aligned free runs)
+    size_t allocatedBytes;
+    size_t usedBytes;
+    size_t wastedBytes;
+    double internalFragmentation; // Wasted bytes / allocated bytes
+    double externalFragmentation; // Share of free memory not usable as pages of this size
+} PageSizeStats;
+
 // Memory manager initialization and cleanup
-MemoryManager *createMemoryManager(MemoryStrategy strategy, size_t totalMemory, size_t pageSize, int maxProcesses);
+MemoryManager *createMemoryManager(MemoryStrategy strategy, size_t totalMemory, size_t pageSize, int maxProcesses,
+                                   PlacementPolicy placement);
 void destroyMemoryManager(MemoryManager *manager);
 
+// Snapshots: the segment list, frame table and process table in a versioned binary file that is mapped on load,
+// so a warmed-up manager can be checkpointed and restored. Attached TLB, swap, analytics, trace and slab caches
+// are not saved; a loaded manager starts without them
+bool saveMemoryManager(MemoryManager *manager, const char *path);
+MemoryManager *loadMemoryManager(const char *path);
+
 // Process management
 int createProcess(MemoryManager *manager, const char *name, size_t size);
 bool terminateProcess(MemoryManager *manager, int processId);
+Process *getProcess(MemoryManager *manager, int processId); // NULL for unknown, terminated or stale ids
+
+// Copy-on-write fork (paging and hybrid strategies without demand paging): the child shares the parent's frames
+// until one of them writes to a page
+int forkProcess(MemoryManager *manager, int processId);
+void printCowStats(MemoryManager *manager);
 
 // Segmentation functions
 bool allocateSegment(MemoryManager *manager, int processId, const char *segmentType, size_t size);
 void deallocateSegments(MemoryManager *manager, int processId);
 
+// Batch allocation: requests are placed exactly as the same allocateSegment calls in order would place them, in
+// one pass over the free structures with one stats update and one log line. Returns the number satisfied;
+// satisfied (optional) gets the outcome of each request
+int allocateSegmentsBatch(MemoryManager *manager, const AllocationRequest *requests, int count, const char *segmentType,
+                          bool *satisfied);
+
+// Compaction (segmentation and hybrid): slide allocated segments toward address 0
+CompactionResult compactMemory(MemoryManager *manager);
+CompactionResult compactMemoryStep(MemoryManager *manager, size_t maxBytes);
+
 // Paging functions
+int findFreePages(MemoryManager *manager, size_t numPages);
+int findFreePagesAligned(MemoryManager *manager, size_t numPages, size_t alignPages);
+long findFreeFrame(MemoryManager *manager, size_t start);
+void setFrameAllocated(MemoryManager *manager, size_t frameNumber, bool allocated);
 bool allocatePages(MemoryManager *manager, int processId, size_t size);
+bool allocatePagesAt(MemoryManager *manager, int processId, size_t virtualAddress, size_t size);
 void deallocatePages(MemoryManager *manager, int processId);
 
+// Batch page allocation: each request grows its process past its highest mapped page, backed by the frames
+// allocatePagesAt would pick; one stats update and one log line for the whole batch
+int allocatePagesBatch(MemoryManager *manager, const AllocationRequest *requests, int count, bool *satisfied);
+
+// Huge pages (paging and hybrid strategies): fully covered, aligned virtual ranges are backed by huge frames
+bool enableHugePages(MemoryManager *manager, size_t hugePageSize);
+
+// Page table queries
+Page *pageTableLookup(PageTable *pageTable, size_t vpage);
+size_t pageTableMemory(const PageTable *pageTable);
+
+// Page access and demand paging (paging and hybrid strategies; enable demand paging before creating processes)
+bool enableDemandPaging(MemoryManager *manager, ReplacementPolicy policy);
+bool accessPage(MemoryManager *manager, int processId, size_t vpage, bool isWrite);
+bool translateAddress(MemoryManager *manager, int processId, size_t virtualAddress, bool isWrite, size_t *physicalAddress);
+void printPagingStats(MemoryManager *manager);
+
+// Strategy and placement policy helpers
+const char *memoryStrategyName(MemoryStrategy strategy);
+const char *placementPolicyName(PlacementPolicy placement);
+const char *replacementPolicyName(ReplacementPolicy policy);
+
 // Memory statistics
+FragmentationStats getFragmentationStats(MemoryManager *manager);
+int getPageSizeStats(MemoryManager *manager, PageSizeStats *stats, int maxSizes);
 void calculateFragmentation(MemoryManager *manager);
 void printMemoryStats(MemoryManager *manager);
 void visualizeMemory(MemoryManager *manager);
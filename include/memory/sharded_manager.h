@@ -0,0 +1,70 @@
+#ifndef SHARDED_MANAGER_H
+#define SHARDED_MANAGER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "memory_manager.h"
+#include "../platform/sync.h"
+
+#define SHARDED_MAX_SHARDS 64
+#define SHARDED_BENCH_LIVE_PROCESSES 64 // Live processes each benchmark thread keeps at most
+
+// Sharded process ids carry the shard in the high 32 bits and the shard's own process id in the low 32
+#define SHARDED_PROCESS_ID(shard, processId) (((int64_t)(shard) << 32) | (uint32_t)(processId))
+#define SHARDED_PROCESS_SHARD(id) ((int)((id) >> 32))
+#define SHARDED_PROCESS_LOCAL(id) ((int)((id) & 0xFFFFFFFF))
+
+// One independently locked slice of the address space
+typedef struct
+{
+    MemoryManager *manager;
+    MutexHandle *lock;
+    size_t baseAddress;  // Where the shard's slice starts in the combined address space
+    size_t acquisitions; // Lock acquisitions (updated under the lock)
+    size_t contended;    // Acquisitions that found the lock already held
+} MemoryShard;
+
+// Thread-safe front for a memory manager: the address space is split into shards, each a full
+// MemoryManager behind its own lock. Each thread allocates from its own home shard and spills to
+// the other shards only when it is full, so threads on different shards never contend
+typedef struct
+{
+    MemoryStrategy strategy;
+    size_t totalMemory;
+    int shardCount;
+    MemoryShard *shards;
+} ShardedMemoryManager;
+
+// Throughput of one multithreaded benchmark run
+typedef struct
+{
+    int threads;
+    int shards;
+    size_t operations;
+    size_t failed;
+    double elapsedSeconds;
+    double opsPerSecond;
+    double contention; // Share of lock acquisitions that had to wait
+} ShardedBenchmarkResult;
+
+// Lifecycle (maxProcesses limits each shard)
+ShardedMemoryManager *createShardedMemoryManager(MemoryStrategy strategy, size_t totalMemory, size_t pageSize,
+                                                 int maxProcesses, PlacementPolicy placement, int shardCount);
+void destroyShardedMemoryManager(ShardedMemoryManager *sharded);
+
+// Thread-safe process and allocation calls (ids are sharded process ids, -1 on failure)
+int64_t shardedCreateProcess(ShardedMemoryManager *sharded, const char *name, size_t size);
+bool shardedTerminateProcess(ShardedMemoryManager *sharded, int64_t processId);
+bool shardedAllocateSegment(ShardedMemoryManager *sharded, int64_t processId, const char *segmentType, size_t size);
+bool shardedAllocatePages(ShardedMemoryManager *sharded, int64_t processId, size_t size);
+bool shardedAllocatePagesAt(ShardedMemoryManager *sharded, int64_t processId, size_t virtualAddress, size_t size);
+
+// Statistics
+void printShardedStats(ShardedMemoryManager *sharded);
+
+// Run opsPerThread create/grow/terminate operations on each of threads threads (logging is silenced)
+ShardedBenchmarkResult runShardedBenchmark(MemoryStrategy strategy, size_t totalMemory, size_t pageSize, PlacementPolicy placement,
+                                           int threads, int shards, size_t opsPerThread, uint64_t seed);
+
+#endif // SHARDED_MANAGER_H
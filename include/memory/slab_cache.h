@@ -0,0 +1,68 @@
+#ifndef SLAB_CACHE_H
+#define SLAB_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "memory_manager.h"
+
+#define SLAB_OBJECT_ALIGN 8 // Object slots are rounded up to this many bytes
+
+struct ObjectCache;
+
+// A single page frame carved into fixed-size object slots
+typedef struct Slab
+{
+    struct ObjectCache *cache; // Cache this slab belongs to
+    size_t frameNumber;        // Page frame backing the slab
+    int freeCount;             // Number of free slots
+    int freeHead;              // First free slot, or -1 when the slab is full
+    int *nextFreeSlot;         // Free-slot chain; SLAB_SLOT_IN_USE for allocated slots
+    struct Slab *next;         // Neighbours in the cache's partial/full/empty list
+    struct Slab *prev;
+} Slab;
+
+#define SLAB_SLOT_IN_USE -2
+
+// Per-cache statistics
+typedef struct
+{
+    size_t activeObjects;  // Objects currently allocated
+    size_t totalAllocs;    // cacheAlloc calls that succeeded
+    size_t totalFrees;     // cacheFree calls that succeeded
+    size_t failedAllocs;   // cacheAlloc calls that found no frame for a new slab
+    size_t slabsCreated;   // Frames taken from the page frame table
+    size_t slabsReleased;  // Frames returned to the page frame table
+} ObjectCacheStats;
+
+// Cache of same-size objects layered on the manager's page frames
+typedef struct ObjectCache
+{
+    MemoryManager *manager;
+    size_t objectSize;  // Requested object size
+    size_t slotSize;    // Object size rounded up to SLAB_OBJECT_ALIGN
+    int objectsPerSlab; // Slots carved from one page frame
+
+    // Slabs by occupancy
+    Slab *partialSlabs;
+    Slab *fullSlabs;
+    Slab *emptySlabs;
+    int slabCount;
+
+    ObjectCacheStats stats;
+} ObjectCache;
+
+// Cache lifecycle (destroy caches before their memory manager)
+ObjectCache *createCache(MemoryManager *manager, size_t objectSize);
+void destroyCache(ObjectCache *cache);
+
+// Object allocation; addresses are physical addresses in the manager's memory
+bool cacheAlloc(ObjectCache *cache, size_t *address);
+bool cacheFree(ObjectCache *cache, size_t address);
+
+// Return the frames of all empty slabs to the page frame table
+size_t cacheShrink(ObjectCache *cache);
+
+// Cache statistics
+void printCacheStats(ObjectCache *cache);
+
+#endif // SLAB_CACHE_H
@@ -0,0 +1,81 @@
+#ifndef SWAP_H
+#define SWAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "memory_manager.h"
+
+// Swap slot recorded in a page table entry
+#define SWAP_NO_SLOT -1      // Contents are not on the swap device
+#define SWAP_SLOT_PENDING -2 // Queued in the writeback buffer, not yet written
+
+#define SWAP_MAX_READAHEAD 32
+#define SWAP_LATENCY_BUCKETS 48 // Bucket i counts I/O operations taking [2^i, 2^(i+1)) ns
+
+// Default costs charged when there is no backing file
+#define SWAP_SIMULATED_SEEK_NS 100000 // Per I/O operation
+#define SWAP_SIMULATED_PAGE_NS 10000  // Per page transferred
+
+// Latency histogram of one direction of swap I/O
+typedef struct
+{
+    size_t buckets[SWAP_LATENCY_BUCKETS];
+    size_t operations;
+    uint64_t totalNs;
+    uint64_t maxNs;
+} SwapLatency;
+
+// Swap statistics
+typedef struct
+{
+    size_t pagesOut;       // Pages written
+    size_t pagesIn;        // Pages read by faults
+    size_t writeBatches;   // Writeback buffer flushes
+    size_t pendingHits;    // Faults served from the writeback buffer before the page was written
+    size_t readaheadPages; // Extra pages read after the faulting one
+    size_t readaheadHits;  // Readahead pages accessed before they were evicted again
+    size_t discarded;      // Dirty pages dropped because every swap slot was taken
+    size_t ioErrors;       // Failed reads or writes, and reads that returned another page's contents
+    SwapLatency outLatency;
+    SwapLatency inLatency;
+} SwapStats;
+
+// Swap area for pages evicted under demand paging. Dirty victims go to a writeback buffer that is
+// flushed in batches, clustered by process and virtual page so each process's pages land in adjacent
+// slots and a fault can read its neighbours ahead in the same operation
+typedef struct SwapDevice
+{
+    FILE *file;             // Backing file (NULL: I/O is simulated with fixed costs)
+    size_t pageSize;
+    size_t slotCount;
+    size_t freeSlots;
+    uint64_t *slotBitmap;   // Bit i set when slot i holds a page
+    size_t slotCursor;      // Where the next search for free slots starts
+    size_t batchPages;      // Dirty pages buffered before a flush
+    Page **pending;         // Entries waiting in the writeback buffer
+    size_t pendingCount;
+    int readahead;          // Following pages read with a faulting one
+    unsigned long seekNs;   // Simulated cost per I/O operation
+    unsigned long pageNs;   // Simulated cost per page
+    unsigned char *buffer;  // I/O staging buffer of max(batchPages, readahead + 1) pages
+    SwapStats stats;
+} SwapDevice;
+
+// Swap lifecycle (path NULL: simulated device)
+SwapDevice *createSwapDevice(const char *path, size_t pageSize, size_t slotCount, size_t batchPages, int readahead);
+void destroySwapDevice(SwapDevice *swap);
+
+// Called by the memory manager as pages are evicted, faulted in, written or unmapped
+void swapQueueWriteback(SwapDevice *swap, Page *entry);
+void flushSwap(SwapDevice *swap);
+bool swapReclaimPending(SwapDevice *swap, Page *entry);
+bool swapReadPages(SwapDevice *swap, Page **entries, size_t count);
+void swapReleaseSlot(SwapDevice *swap, Page *entry);
+
+// Swap statistics
+uint64_t swapLatencyPercentile(const SwapLatency *latency, double percentile);
+void printSwapStats(SwapDevice *swap);
+
+#endif // SWAP_H
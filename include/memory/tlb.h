@@ -0,0 +1,74 @@
+#ifndef TLB_H
+#define TLB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define TLB_HIT_CYCLES 1 // Cycles charged for a translation that hits the TLB
+
+struct Page;
+
+// Replacement policies within a TLB set
+typedef enum
+{
+    TLB_REPLACE_LRU,
+    TLB_REPLACE_RANDOM
+} TlbReplacement;
+
+// A cached virtual-to-physical page translation
+typedef struct
+{
+    bool valid;
+    int asid;                 // Address space (process) the translation belongs to
+    size_t vpage;             // Virtual page number
+    size_t frameNumber;       // Physical frame it maps to
+    struct Page *pageEntry;   // Page table entry the translation was read from
+    unsigned long lastUsed;   // Access stamp for LRU
+} TlbEntry;
+
+// TLB statistics
+typedef struct
+{
+    size_t lookups;
+    size_t hits;
+    size_t misses;
+    size_t evictions;           // Valid entries replaced by a fill
+    size_t flushes;             // Full flushes on address-space switches (untagged TLBs only)
+    size_t shootdowns;          // Invalidation requests from unmapping or evicting pages
+    size_t entriesShotDown;     // Valid entries removed by those requests
+    unsigned long missCycles;   // Cycles spent on page table walks after misses
+} TlbStats;
+
+// Set-associative translation lookaside buffer
+typedef struct Tlb
+{
+    int entryCount;
+    int ways;                    // Entries per set (entryCount for fully associative)
+    int sets;
+    TlbReplacement replacement;
+    bool useAsid;                // Tag entries with an ASID; untagged TLBs flush on every switch
+    int currentAsid;             // Address space of the last lookup (-1 before the first)
+    unsigned long missPenalty;   // Cycles charged for each miss
+    unsigned long clock;         // Access stamp source for LRU
+    unsigned int randomState;    // xorshift state for random replacement
+    TlbEntry *entries;           // sets * ways entries, set-major
+    TlbStats stats;
+} Tlb;
+
+// TLB lifecycle
+Tlb *createTlb(int entryCount, int ways, TlbReplacement replacement, bool useAsid, unsigned long missPenalty);
+void destroyTlb(Tlb *tlb);
+
+// Translation cache operations
+bool tlbLookup(Tlb *tlb, int asid, size_t vpage, size_t *frameNumber, struct Page **pageEntry);
+void tlbInsert(Tlb *tlb, int asid, size_t vpage, size_t frameNumber, struct Page *pageEntry);
+
+// Shootdowns; each returns the number of valid entries removed
+int tlbInvalidatePage(Tlb *tlb, int asid, size_t vpage);
+int tlbInvalidateAsid(Tlb *tlb, int asid);
+
+// TLB statistics
+double tlbHitRate(const Tlb *tlb);
+void printTlbStats(Tlb *tlb);
+
+#endif // TLB_H
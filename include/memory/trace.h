@@ -0,0 +1,106 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "memory_manager.h"
+
+#define TRACE_FORMAT_HEADER "# mlrwsmm trace v1" // First line of every trace file
+#define TRACE_NAME_LENGTH 32
+#define TRACE_NO_ADDRESS ((size_t)-1) // Allocate event without a virtual address
+
+// Workload events, one per trace line: "<timestamp_us> <C|A|T|X|F> <pid> [args]"
+typedef enum
+{
+    TRACE_CREATE,    // C <pid> <size> <name>: createProcess
+    TRACE_ALLOCATE,  // A <pid> <size> [virtual address]: grow a live process (allocateSegment, or allocatePagesAt
+                     // at the address; without one, past its mapping)
+    TRACE_TERMINATE, // T <pid>: terminateProcess
+    TRACE_ACCESS,    // X <pid> <virtual address> <R|W>: translateAddress
+    TRACE_FORK       // F <pid> <parent pid>: forkProcess (pid is the child)
+} TraceEventType;
+
+typedef struct
+{
+    TraceEventType type;
+    unsigned long timestamp; // Microseconds since recording started
+    int processId;           // Process id in the recorded run; replay maps it to the replaying manager's id
+    size_t value;            // Size for create/allocate, virtual address for access, recorded parent id for fork
+    size_t address;          // Virtual address of a page mapping for allocate, otherwise TRACE_NO_ADDRESS
+    bool isWrite;
+    char name[TRACE_NAME_LENGTH];
+} TraceEvent;
+
+// Appends events to a trace file; attach to a manager through manager->trace to record a run
+typedef struct TraceWriter
+{
+    FILE *file;
+    uint64_t startNs; // Monotonic clock when recording started
+    size_t events;
+} TraceWriter;
+
+// Reads events back from a trace file
+typedef struct
+{
+    FILE *file;
+    size_t line;
+} TraceReader;
+
+// Fragmentation sampled during a replay
+typedef struct
+{
+    size_t event;            // Events replayed when the sample was taken
+    unsigned long timestamp; // Trace timestamp of that event
+    size_t usedMemory;
+    double externalFragmentation;
+    double internalFragmentation;
+} ReplaySample;
+
+// Outcome of replaying a trace (or running a generated workload) against a manager
+typedef struct
+{
+    size_t events;
+    size_t failed;            // Operations the manager rejected (out of memory, invalid access, ...)
+    size_t skipped;           // Events for processes that were never created, or accesses without a page table
+    double elapsedSeconds;    // Time spent inside the manager
+    double opsPerSecond;
+    double latencyNs[5];      // p50, p90, p99, p99.9 and max latency per operation
+    ReplaySample *samples;    // Fragmentation every sampleInterval events
+    size_t sampleCount;
+} ReplayResult;
+
+// Collects per-operation latencies and periodic fragmentation samples while a workload runs
+typedef struct
+{
+    ReplayResult result;
+    size_t sampleInterval;
+    uint64_t *latencies;
+    size_t latencyCount;
+    size_t latencyCapacity;
+    size_t sampleCapacity;
+    uint64_t totalNs;
+} ReplayMeter;
+
+// Trace files
+TraceWriter *openTraceWriter(const char *path);
+void closeTraceWriter(TraceWriter *writer);
+void traceRecord(TraceWriter *writer, TraceEventType type, int processId, size_t value, bool isWrite, const char *name);
+void traceRecordAllocateAt(TraceWriter *writer, int processId, size_t size, size_t virtualAddress);
+TraceReader *openTraceReader(const char *path);
+bool traceNext(TraceReader *reader, TraceEvent *event);
+void closeTraceReader(TraceReader *reader);
+
+// Headless replay (manager logging is silenced while the trace runs)
+ReplayResult replayTrace(MemoryManager *manager, const char *path, size_t sampleInterval);
+void printReplayResult(const ReplayResult *result);
+void freeReplayResult(ReplayResult *result);
+
+// Measurement shared by trace replay and generated workloads
+void initReplayMeter(ReplayMeter *meter, size_t sampleInterval);
+bool replayMeterRecord(ReplayMeter *meter, uint64_t elapsedNs, bool success);
+bool replayMeterEvent(ReplayMeter *meter, MemoryManager *manager, unsigned long timestamp);
+ReplayResult finishReplayMeter(ReplayMeter *meter);
+
+#endif // TRACE_H
@@ -0,0 +1,54 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "memory_manager.h"
+#include "trace.h"
+
+// Shapes for generated process sizes and lifetimes
+typedef enum
+{
+    DIST_FIXED,       // a
+    DIST_UNIFORM,     // Between a and b
+    DIST_EXPONENTIAL, // Mean a
+    DIST_PARETO,      // Scale (minimum) a, shape b; heavy tailed
+    DIST_BIMODAL      // Modes around a and b (10% spread each), the b mode with probability c
+} DistributionType;
+
+typedef struct
+{
+    DistributionType type;
+    double a;
+    double b;
+    double c;
+} Distribution;
+
+// A generated workload: one process arrives per tick and lives for a sampled number of ticks
+typedef struct
+{
+    uint64_t seed;
+    size_t events;             // Creates plus terminates to generate
+    Distribution size;         // Bytes per process
+    Distribution lifetime;     // Ticks before the process terminates
+    size_t sampleInterval;     // Events between fragmentation samples (0: none)
+} WorkloadConfig;
+
+// Seeded random source, so a seed always produces the same workload
+typedef struct
+{
+    uint64_t state;
+} WorkloadRandom;
+
+// Sampling
+void seedWorkloadRandom(WorkloadRandom *random, uint64_t seed);
+double workloadUniform(WorkloadRandom *random);
+double sampleDistribution(WorkloadRandom *random, const Distribution *distribution);
+const char *distributionName(DistributionType type);
+bool parseDistribution(const char *spec, Distribution *distribution);
+
+// Stream a generated workload into a manager (logging is silenced while it runs)
+ReplayResult runWorkload(MemoryManager *manager, const WorkloadConfig *config);
+
+#endif // WORKLOAD_H
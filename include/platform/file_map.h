@@ -0,0 +1,16 @@
+#ifndef PLATFORM_FILE_MAP_H
+#define PLATFORM_FILE_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Read-only mapping of a whole file
+typedef struct MappedFile MappedFile;
+
+// File mapping operations
+MappedFile *map_file(const char *path);
+const void *mapped_file_data(MappedFile *file);
+size_t mapped_file_size(MappedFile *file);
+bool unmap_file(MappedFile *file);
+
+#endif // PLATFORM_FILE_MAP_H
@@ -3,15 +3,17 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 // Handle types for synchronization primitives
 typedef struct MutexHandle MutexHandle;
 typedef struct SemaphoreHandle SemaphoreHandle;
 
-// Mutex operations
+// Mutex operations (a NULL name creates an unnamed mutex)
 MutexHandle *create_mutex(const char *name);
 MutexHandle *open_mutex(const char *name);
 bool lock_mutex(MutexHandle *handle);
+bool try_lock_mutex(MutexHandle *handle); // Returns false without waiting if the mutex is held
 bool unlock_mutex(MutexHandle *handle);
 bool close_mutex(MutexHandle *handle);
 
@@ -25,6 +27,9 @@ bool close_semaphore(SemaphoreHandle *handle);
 // Platform-independent wait function
 void platform_sleep(unsigned int milliseconds);
 
+// Platform-independent monotonic clock for timing, in nanoseconds
+uint64_t platform_monotonic_ns();
+
 // Platform-independent keyboard input functions
 int getch();
 
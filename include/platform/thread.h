@@ -0,0 +1,27 @@
+#ifndef PLATFORM_THREAD_H
+#define PLATFORM_THREAD_H
+
+#include <stdbool.h>
+
+// Storage class for per-thread variables
+#ifdef _MSC_VER
+#define PLATFORM_THREAD_LOCAL __declspec(thread)
+#else
+#define PLATFORM_THREAD_LOCAL __thread
+#endif
+
+// Thread handle structure
+typedef struct ThreadHandle ThreadHandle;
+
+// Entry point run on a new thread
+typedef void (*ThreadFunction)(void *arg);
+
+// Thread creation and management
+ThreadHandle *create_thread(ThreadFunction function, void *arg);
+bool join_thread(ThreadHandle *handle); // Waits for the thread to finish and frees the handle
+int get_cpu_count();
+
+// Atomically add one and return the new value
+long atomic_increment(volatile long *value);
+
+#endif // PLATFORM_THREAD_H
@@ -44,6 +44,10 @@ int init_logger(int log_output_code, int log_verbosity_code)
 
 void log_msg(int status_level, char *log_message, const char *file_path, int line)
 {
+    if (log_output == LOG_TO_NONE)
+    {
+        return;
+    }
 
     const char *color;
     const char *type_message;
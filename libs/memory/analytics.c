@@ -0,0 +1,371 @@
+#include "../../include/memory/analytics.h"
+#include "../../include/memory/bitops.h"
+#include "../../include/log/logger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// Fenwick tree update at index i (0-based) by delta
+static void treeAdd(ProcessAnalytics *process, size_t i, int delta)
+{
+    for (size_t k = i + 1; k <= process->treeCapacity; k += k & (~k + 1))
+    {
+        process->tree[k - 1] += delta;
+    }
+}
+
+// Marks at indices 0..i
+static size_t treePrefix(const ProcessAnalytics *process, size_t i)
+{
+    size_t sum = 0;
+    for (size_t k = i + 1; k > 0; k -= k & (~k + 1))
+    {
+        sum += process->tree[k - 1];
+    }
+    return sum;
+}
+
+static size_t hashPage(size_t vpage, size_t capacity)
+{
+    return (size_t)(((uint64_t)vpage * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+}
+
+// Entry for vpage in the page table: its own, or the empty slot where it would go
+static AnalyticsPage *findPage(ProcessAnalytics *process, size_t vpage)
+{
+    size_t slot = hashPage(vpage, process->pageCapacity);
+    while (process->pages[slot].used && process->pages[slot].vpage != vpage)
+    {
+        slot = (slot + 1) & (process->pageCapacity - 1);
+    }
+    return &process->pages[slot];
+}
+
+// Double the page table, rehashing every page
+static bool growPages(ProcessAnalytics *process)
+{
+    size_t oldCapacity = process->pageCapacity;
+    AnalyticsPage *oldPages = process->pages;
+    AnalyticsPage *pages = (AnalyticsPage *)calloc(oldCapacity * 2, sizeof(AnalyticsPage));
+    if (!pages)
+    {
+        error("Failed to grow analytics page table");
+        return false;
+    }
+
+    process->pages = pages;
+    process->pageCapacity = oldCapacity * 2;
+    for (size_t i = 0; i < oldCapacity; i++)
+    {
+        if (oldPages[i].used)
+        {
+            *findPage(process, oldPages[i].vpage) = oldPages[i];
+        }
+    }
+    free(oldPages);
+    return true;
+}
+
+static int compareIndex(const void *a, const void *b)
+{
+    size_t x = (*(const AnalyticsPage *const *)a)->index;
+    size_t y = (*(const AnalyticsPage *const *)b)->index;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// Out of indices: renumber the live marks (one per page, in access order) from 0 and rebuild the tree,
+// leaving at least as many free indices as pages so the work amortises to O(log n) per access
+static bool compactTree(ProcessAnalytics *process)
+{
+    size_t capacity = process->pageCount * 2 > process->treeCapacity ? process->pageCount * 2 : process->treeCapacity;
+    AnalyticsPage **live = (AnalyticsPage **)malloc((process->pageCount + 1) * sizeof(AnalyticsPage *));
+    uint32_t *tree = (uint32_t *)calloc(capacity, sizeof(uint32_t));
+    uint64_t *indexTime = (uint64_t *)malloc(capacity * sizeof(uint64_t));
+    if (!live || !tree || !indexTime)
+    {
+        error("Failed to compact analytics access tree");
+        free(live);
+        free(tree);
+        free(indexTime);
+        return false;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < process->pageCapacity; i++)
+    {
+        if (process->pages[i].used)
+        {
+            live[count++] = &process->pages[i];
+        }
+    }
+    qsort(live, count, sizeof(AnalyticsPage *), compareIndex);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        indexTime[i] = process->indexTime[live[i]->index];
+        live[i]->index = i;
+    }
+
+    // Linear-time Fenwick build: ones at the first count indices, each node passed up to its parent
+    for (size_t k = 1; k <= capacity; k++)
+    {
+        if (k <= count)
+        {
+            tree[k - 1] += 1;
+        }
+        size_t parent = k + (k & (~k + 1));
+        if (parent <= capacity)
+        {
+            tree[parent - 1] += tree[k - 1];
+        }
+    }
+
+    free(live);
+    free(process->tree);
+    free(process->indexTime);
+    process->tree = tree;
+    process->indexTime = indexTime;
+    process->treeCapacity = capacity;
+    process->nextIndex = count;
+    return true;
+}
+
+// Start a fresh history in a table slot for processId
+static bool resetProcess(ProcessAnalytics *process, int processId)
+{
+    free(process->tree);
+    free(process->indexTime);
+    free(process->pages);
+    memset(process, 0, sizeof(ProcessAnalytics));
+    process->processId = -1;
+
+    process->tree = (uint32_t *)calloc(ANALYTICS_INITIAL_CAPACITY, sizeof(uint32_t));
+    process->indexTime = (uint64_t *)malloc(ANALYTICS_INITIAL_CAPACITY * sizeof(uint64_t));
+    process->pages = (AnalyticsPage *)calloc(ANALYTICS_INITIAL_CAPACITY, sizeof(AnalyticsPage));
+    if (!process->tree || !process->indexTime || !process->pages)
+    {
+        error("Failed to allocate process analytics");
+        return false;
+    }
+
+    process->processId = processId;
+    process->treeCapacity = ANALYTICS_INITIAL_CAPACITY;
+    process->pageCapacity = ANALYTICS_INITIAL_CAPACITY;
+    return true;
+}
+
+// Track working sets over the last window accesses of each process
+AccessAnalytics *createAccessAnalytics(size_t window)
+{
+    if (window == 0)
+    {
+        error("Cannot create access analytics: the working-set window must be at least one access");
+        return NULL;
+    }
+
+    AccessAnalytics *analytics = (AccessAnalytics *)malloc(sizeof(AccessAnalytics));
+    if (!analytics)
+    {
+        error("Failed to allocate memory for access analytics");
+        return NULL;
+    }
+
+    analytics->window = window;
+    analytics->processes = NULL;
+    analytics->processCapacity = 0;
+
+    char logMsg[100];
+    sprintf(logMsg, "Created access analytics with a %zu-access working-set window", window);
+    info(logMsg);
+
+    return analytics;
+}
+
+void destroyAccessAnalytics(AccessAnalytics *analytics)
+{
+    if (!analytics)
+        return;
+
+    for (int i = 0; i < analytics->processCapacity; i++)
+    {
+        free(analytics->processes[i].tree);
+        free(analytics->processes[i].indexTime);
+        free(analytics->processes[i].pages);
+    }
+    free(analytics->processes);
+    free(analytics);
+}
+
+// History for processId, created (or restarted when the slot changed hands) on demand
+static ProcessAnalytics *trackProcess(AccessAnalytics *analytics, int processId)
+{
+    int slot = PROCESS_SLOT(processId);
+    if (slot >= analytics->processCapacity)
+    {
+        int capacity = analytics->processCapacity ? analytics->processCapacity : 16;
+        while (capacity <= slot)
+        {
+            capacity *= 2;
+        }
+
+        ProcessAnalytics *processes = (ProcessAnalytics *)realloc(analytics->processes, capacity * sizeof(ProcessAnalytics));
+        if (!processes)
+        {
+            error("Failed to grow access analytics");
+            return NULL;
+        }
+        memset(&processes[analytics->processCapacity], 0, (capacity - analytics->processCapacity) * sizeof(ProcessAnalytics));
+        for (int i = analytics->processCapacity; i < capacity; i++)
+        {
+            processes[i].processId = -1;
+        }
+        analytics->processes = processes;
+        analytics->processCapacity = capacity;
+    }
+
+    ProcessAnalytics *process = &analytics->processes[slot];
+    if (process->processId != processId && !resetProcess(process, processId))
+    {
+        return NULL;
+    }
+    return process;
+}
+
+// Record an access: its reuse distance is the number of distinct pages touched since the page's last
+// access, and the working set is the number of distinct pages touched in the last window accesses
+void analyticsRecordAccess(AccessAnalytics *analytics, int processId, size_t vpage)
+{
+    ProcessAnalytics *process = trackProcess(analytics, processId);
+    if (!process)
+    {
+        return;
+    }
+
+    if (process->nextIndex == process->treeCapacity && !compactTree(process))
+    {
+        return;
+    }
+    if ((process->pageCount + 1) * 2 > process->pageCapacity && !growPages(process))
+    {
+        return;
+    }
+
+    process->time++;
+    AnalyticsPage *page = findPage(process, vpage);
+    if (page->used)
+    {
+        size_t distance = treePrefix(process, process->nextIndex - 1) - treePrefix(process, page->index);
+        int bucket = distance == 0 ? 0 : highestBit64((uint64_t)distance) + 1;
+        process->distanceBuckets[bucket < ANALYTICS_DISTANCE_BUCKETS ? bucket : ANALYTICS_DISTANCE_BUCKETS - 1]++;
+        treeAdd(process, page->index, -1);
+    }
+    else
+    {
+        page->used = true;
+        page->vpage = vpage;
+        process->pageCount++;
+        process->coldAccesses++;
+    }
+
+    page->index = process->nextIndex++;
+    process->indexTime[page->index] = process->time;
+    treeAdd(process, page->index, 1);
+
+    // First index inside the window, found by binary search over the ascending access times
+    size_t low = 0;
+    size_t high = process->nextIndex - 1;
+    if (process->time > analytics->window)
+    {
+        uint64_t windowStart = process->time - analytics->window;
+        while (low < high)
+        {
+            size_t middle = low + (high - low) / 2;
+            if (process->indexTime[middle] > windowStart)
+                high = middle;
+            else
+                low = middle + 1;
+        }
+    }
+
+    process->workingSet = treePrefix(process, process->nextIndex - 1) - (low > 0 ? treePrefix(process, low - 1) : 0);
+    process->workingSetSum += process->workingSet;
+    if (process->workingSet > process->peakWorkingSet)
+    {
+        process->peakWorkingSet = process->workingSet;
+    }
+}
+
+ProcessAnalytics *getProcessAnalytics(AccessAnalytics *analytics, int processId)
+{
+    if (processId < 0 || PROCESS_SLOT(processId) >= analytics->processCapacity)
+    {
+        return NULL;
+    }
+
+    ProcessAnalytics *process = &analytics->processes[PROCESS_SLOT(processId)];
+    return process->processId == processId ? process : NULL;
+}
+
+// Reuse distance below which the given share of re-references fall (upper bound of its bucket)
+size_t reuseDistancePercentile(const ProcessAnalytics *process, double percentile)
+{
+    size_t reuses = process->time - process->coldAccesses;
+    size_t seen = 0;
+    for (int bucket = 0; bucket < ANALYTICS_DISTANCE_BUCKETS; bucket++)
+    {
+        seen += process->distanceBuckets[bucket];
+        if (seen > 0 && seen >= percentile * reuses)
+        {
+            return bucket == 0 ? 0 : ((size_t)1 << bucket) - 1;
+        }
+    }
+    return process->pageCount;
+}
+
+// Frames an LRU-managed process needs so that hitRatio of its re-references hit: an access hits with
+// k frames exactly when its reuse distance is below k
+size_t suggestFrameQuota(const ProcessAnalytics *process, double hitRatio)
+{
+    size_t quota = reuseDistancePercentile(process, hitRatio) + 1;
+    return quota < process->pageCount ? quota : process->pageCount;
+}
+
+// Print each tracked process's working set, reuse-distance distribution and suggested frame quotas
+void printAccessAnalytics(AccessAnalytics *analytics)
+{
+    if (!analytics)
+        return;
+
+    char logMsg[512];
+    sprintf(logMsg, "======== Access Analytics (%zu-access window) ========", analytics->window);
+    info(logMsg);
+
+    for (int i = 0; i < analytics->processCapacity; i++)
+    {
+        ProcessAnalytics *process = &analytics->processes[i];
+        if (process->processId < 0 || process->time == 0)
+            continue;
+
+        sprintf(logMsg, "Process %d: %llu accesses to %zu pages; working set: %zu now, %.1f average, %zu peak",
+                process->processId, (unsigned long long)process->time, process->pageCount, process->workingSet,
+                (double)process->workingSetSum / process->time, process->peakWorkingSet);
+        info(logMsg);
+
+        sprintf(logMsg, "  Reuse distance: p50 <= %zu, p90 <= %zu, p99 <= %zu, cold: %zu; LRU frames for 90%%/99%% hits: %zu/%zu",
+                reuseDistancePercentile(process, 0.50), reuseDistancePercentile(process, 0.90),
+                reuseDistancePercentile(process, 0.99), process->coldAccesses,
+                suggestFrameQuota(process, 0.90), suggestFrameQuota(process, 0.99));
+        info(logMsg);
+
+        // Histogram as "<upper bound>:<count>" for the non-empty buckets
+        int length = sprintf(logMsg, "  Distances:");
+        for (int bucket = 0; bucket < ANALYTICS_DISTANCE_BUCKETS && length < (int)sizeof(logMsg) - 40; bucket++)
+        {
+            if (process->distanceBuckets[bucket] > 0)
+            {
+                length += sprintf(logMsg + length, " <%zu:%zu", (size_t)1 << bucket, process->distanceBuckets[bucket]);
+            }
+        }
+        info(logMsg);
+    }
+}
@@ -1,12 +1,35 @@
 #include "../../include/memory/memory_manager.h"
+#include "../../include/memory/bitops.h"
+#include "../../include/memory/tlb.h"
+#include "../../include/memory/swap.h"
+#include "../../include/memory/analytics.h"
+#include "../../include/memory/trace.h"
+#include "../../include/platform/file_map.h"
 #include "../../include/log/logger.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
+#include <limits.h>
+#include <time.h>
+
+static void indexFreeSegment(MemoryManager *manager, MemorySegment *segment);
+static void unindexFreeSegment(MemoryManager *manager, MemorySegment *segment);
+static MemorySegment *findSegregatedFit(MemoryManager *manager, size_t size);
+static MemorySegment *createFreeSegment(MemoryManager *manager, size_t address, size_t size);
+static MemorySegment *allocSegmentNode(MemoryManager *manager);
+static void releaseSegmentNode(MemoryManager *manager, MemorySegment *segment);
+static void initBuddyBlocks(MemoryManager *manager);
+static void initPageFrames(MemoryManager *manager);
+static void tlsfInsertFree(MemoryManager *manager, MemorySegment *block);
+static void residencyRemove(MemoryManager *manager, Page *entry);
+static void releasePageTableNode(MemoryManager *manager, void *node, int level, size_t *freedPages, size_t *freedMemory);
+static long findFreeRun(MemoryManager *manager, size_t position, size_t numPages, size_t alignPages,
+                        size_t *longestSkipped);
 
 // Create a new memory manager instance
-MemoryManager *createMemoryManager(MemoryStrategy strategy, size_t totalMemory, size_t pageSize, int maxProcesses)
+MemoryManager *createMemoryManager(MemoryStrategy strategy, size_t totalMemory, size_t pageSize, int maxProcesses,
+                                   PlacementPolicy placement)
 {
     MemoryManager *manager = (MemoryManager *)malloc(sizeof(MemoryManager));
     if (!manager)
@@ -23,24 +46,70 @@ MemoryManager *createMemoryManager(MemoryStrategy strategy, size_t totalMemory,
     manager->externalFragmentation = 0.0;
     manager->internalFragmentation = 0.0;
 
-    manager->processes = (Process *)malloc(maxProcesses * sizeof(Process));
+    // The process table starts small and doubles as processes are created
+    manager->maxProcesses = maxProcesses < PROCESS_MAX_SLOTS ? maxProcesses : PROCESS_MAX_SLOTS;
+    manager->processCapacity = manager->maxProcesses < PROCESS_TABLE_INITIAL_SLOTS ? manager->maxProcesses : PROCESS_TABLE_INITIAL_SLOTS;
+    manager->processes = (Process *)malloc(manager->processCapacity * sizeof(Process));
+    manager->freeProcessSlots = (int *)malloc(manager->processCapacity * sizeof(int));
     manager->processCount = 0;
-    manager->maxProcesses = maxProcesses;
+    manager->processSlots = 0;
+    manager->freeProcessSlotCount = 0;
+
+    manager->segmentChunks = NULL;
+    manager->freeSegmentNodes = NULL;
+
+    manager->placement = placement;
+    memset(manager->freeBins, 0, sizeof(manager->freeBins));
+    manager->freeBinMap = 0;
+    manager->freeTree = NULL;
+    manager->nextFitCursor = NULL;
+    manager->compactCursor = NULL;
+    manager->compactOnFailure = false;
+
+    manager->buddyMinBlock = 0;
+    manager->buddyMaxOrder = 0;
+    memset(manager->buddyFreeLists, 0, sizeof(manager->buddyFreeLists));
+    manager->buddyOrderMap = 0;
+    memset(manager->buddyFreeBitmap, 0, sizeof(manager->buddyFreeBitmap));
+    manager->buddyBlockTable = NULL;
+
+    manager->frameBitmap = NULL;
+    manager->hugePageSize = 0;
+    manager->hugePagesAllocated = 0;
+    manager->hugeFrameUsedBytes = 0;
+
+    manager->demandPaging = false;
+    manager->replacement = REPLACEMENT_FIFO;
+    memset(manager->residencyHead, 0, sizeof(manager->residencyHead));
+    memset(manager->residencyTail, 0, sizeof(manager->residencyTail));
+    memset(manager->residencySize, 0, sizeof(manager->residencySize));
+    manager->arcTarget = 0;
+    memset(&manager->pagingStats, 0, sizeof(manager->pagingStats));
+    memset(&manager->cowStats, 0, sizeof(manager->cowStats));
+    manager->tlb = NULL;
+    manager->swap = NULL;
+    manager->analytics = NULL;
+    manager->trace = NULL;
+
+    manager->freeBlockBytes = 0;
+    manager->freeBlockCount = 0;
+    manager->freeBlockHeap = NULL;
+    manager->freeBlockHeapCapacity = 0;
+    manager->allocatedBlockBytes = 0;
+    manager->wastedBlockBytes = 0;
+    manager->frameUsedBytes = 0;
+
+    manager->tlsfFlBitmap = 0;
+    memset(manager->tlsfSlBitmap, 0, sizeof(manager->tlsfSlBitmap));
+    memset(manager->tlsfFreeLists, 0, sizeof(manager->tlsfFreeLists));
 
     // Initialize structures based on strategy
     switch (strategy)
     {
     case SEGMENTATION:
         // Initialize a single free segment that spans the entire memory
-        manager->segmentList = (MemorySegment *)malloc(sizeof(MemorySegment));
-        manager->segmentList->id = 0;
-        manager->segmentList->size = totalMemory;
-        manager->segmentList->address = 0;
-        manager->segmentList->allocated = false;
-        strcpy(manager->segmentList->processName, "none");
-        manager->segmentList->processId = -1;
-        strcpy(manager->segmentList->segmentType, "free");
-        manager->segmentList->next = NULL;
+        manager->segmentList = createFreeSegment(manager, 0, totalMemory);
+        indexFreeSegment(manager, manager->segmentList);
 
         // Paging structures not needed
         manager->totalPages = 0;
@@ -54,15 +123,7 @@ MemoryManager *createMemoryManager(MemoryStrategy strategy, size_t totalMemory,
         manager->freePages = manager->totalPages;
 
         // Allocate page frames
-        manager->pageFrames = (Page *)malloc(manager->totalPages * sizeof(Page));
-        for (size_t i = 0; i < manager->totalPages; i++)
-        {
-            manager->pageFrames[i].id = i;
-            manager->pageFrames[i].frameNumber = i;
-            manager->pageFrames[i].allocated = false;
-            manager->pageFrames[i].processId = -1;
-            manager->pageFrames[i].usedBytes = 0;
-        }
+        initPageFrames(manager);
 
         // Segmentation structure set to NULL
         manager->segmentList = NULL;
@@ -70,37 +131,47 @@ MemoryManager *createMemoryManager(MemoryStrategy strategy, size_t totalMemory,
 
     case HYBRID:
         // Initialize both segmentation and paging structures
-        manager->segmentList = (MemorySegment *)malloc(sizeof(MemorySegment));
-        manager->segmentList->id = 0;
-        manager->segmentList->size = totalMemory;
-        manager->segmentList->address = 0;
-        manager->segmentList->allocated = false;
-        strcpy(manager->segmentList->processName, "none");
-        manager->segmentList->processId = -1;
-        strcpy(manager->segmentList->segmentType, "free");
-        manager->segmentList->next = NULL;
+        manager->segmentList = createFreeSegment(manager, 0, totalMemory);
+        indexFreeSegment(manager, manager->segmentList);
 
         // Also initialize paging structures
         manager->totalPages = totalMemory / pageSize;
         manager->freePages = manager->totalPages;
 
-        manager->pageFrames = (Page *)malloc(manager->totalPages * sizeof(Page));
-        for (size_t i = 0; i < manager->totalPages; i++)
+        initPageFrames(manager);
+        break;
+
+    case BUDDY:
+        // Power-of-two blocks, with the page size (if any) as the smallest block
+        manager->buddyMinBlock = BUDDY_DEFAULT_MIN_BLOCK;
+        if (pageSize > 0)
         {
-            manager->pageFrames[i].id = i;
-            manager->pageFrames[i].frameNumber = i;
-            manager->pageFrames[i].allocated = false;
-            manager->pageFrames[i].processId = -1;
-            manager->pageFrames[i].usedBytes = 0;
+            manager->buddyMinBlock = pageSize > 1 ? (size_t)1 << (highestBit64((uint64_t)pageSize - 1) + 1) : 1;
         }
+        manager->segmentList = NULL;
+        initBuddyBlocks(manager);
+
+        // Paging structures not needed
+        manager->totalPages = 0;
+        manager->freePages = 0;
+        manager->pageFrames = NULL;
+        break;
+
+    case TLSF:
+        // A single free block spanning the entire memory
+        manager->segmentList = createFreeSegment(manager, 0, totalMemory);
+        tlsfInsertFree(manager, manager->segmentList);
+
+        // Paging structures not needed
+        manager->totalPages = 0;
+        manager->freePages = 0;
+        manager->pageFrames = NULL;
         break;
     }
 
-    char logMsg[100];
-    sprintf(logMsg, "Memory manager created with strategy: %s, total memory: %zu bytes",
-            strategy == SEGMENTATION ? "Segmentation" : strategy == PAGING ? "Paging"
-                                                                           : "Hybrid",
-            totalMemory);
+    char logMsg[150];
+    sprintf(logMsg, "Memory manager created with strategy: %s, placement: %s, total memory: %zu bytes",
+            memoryStrategyName(strategy), placementPolicyName(placement), totalMemory);
     info(logMsg);
 
     return manager;
@@ -112,48 +183,46 @@ void destroyMemoryManager(MemoryManager *manager)
     if (!manager)
         return;
 
-    // Free segmentation structures
-    MemorySegment *current = manager->segmentList;
-    while (current)
+    // Free every segment node in one shot
+    SegmentChunk *chunk = manager->segmentChunks;
+    while (chunk)
+    {
+        SegmentChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    // Free buddy bookkeeping
+    for (int order = 0; order < BUDDY_MAX_ORDERS; order++)
     {
-        MemorySegment *next = current->next;
-        free(current);
-        current = next;
+        free(manager->buddyFreeBitmap[order]);
     }
+    free(manager->buddyBlockTable);
+    free(manager->freeBlockHeap);
 
     // Free paging structures
     if (manager->pageFrames)
     {
         free(manager->pageFrames);
     }
+    free(manager->frameBitmap);
 
     // Free processes and their structures
-    for (int i = 0; i < manager->processCount; i++)
+    for (int i = 0; i < manager->processSlots; i++)
     {
         Process *proc = &manager->processes[i];
 
-        // Free process segments
-        MemorySegment *seg = proc->segments;
-        while (seg)
-        {
-            MemorySegment *next = seg->next;
-            free(seg);
-            seg = next;
-        }
-
         // Free page table
-        if (proc->pageTable)
+        if (proc->state != PROCESS_FREE && proc->pageTable)
         {
-            if (proc->pageTable->pages)
-            {
-                free(proc->pageTable->pages);
-            }
+            releasePageTableNode(NULL, proc->pageTable->root, PAGE_TABLE_LEVELS, NULL, NULL);
             free(proc->pageTable);
         }
     }
 
     // Free processes array
     free(manager->processes);
+    free(manager->freeProcessSlots);
 
     // Free the manager itself
     free(manager);
@@ -161,1049 +230,4699 @@ void destroyMemoryManager(MemoryManager *manager)
     info("Memory manager destroyed");
 }
 
-// Find a suitable segment using first-fit algorithm
-MemorySegment *findFreeSegment(MemoryManager *manager, size_t size)
+// Take a segment node from the manager's pool, carving a new chunk when the free list is empty
+static MemorySegment *allocSegmentNode(MemoryManager *manager)
 {
-    MemorySegment *current = manager->segmentList;
-
-    while (current)
+    if (!manager->freeSegmentNodes)
     {
-        if (!current->allocated && current->size >= size)
+        SegmentChunk *chunk = (SegmentChunk *)malloc(sizeof(SegmentChunk));
+        size_t heapCapacity = manager->freeBlockHeapCapacity + SEGMENT_POOL_CHUNK_NODES;
+        MemorySegment **heap = chunk ? (MemorySegment **)realloc(manager->freeBlockHeap, heapCapacity * sizeof(MemorySegment *)) : NULL;
+        if (!chunk || !heap)
         {
-            return current;
+            error("Failed to allocate memory for segment node chunk");
+            free(chunk);
+            return NULL;
         }
-        current = current->next;
-    }
-
-    return NULL;
-}
-
-// Find contiguous free pages
-int findFreePages(MemoryManager *manager, size_t numPages)
-{
-    int consecutiveCount = 0;
-    int startFrame = -1;
+        manager->freeBlockHeap = heap;
+        manager->freeBlockHeapCapacity = heapCapacity;
 
-    for (size_t i = 0; i < manager->totalPages; i++)
-    {
-        if (!manager->pageFrames[i].allocated)
-        {
-            if (consecutiveCount == 0)
-            {
-                startFrame = i;
-            }
-            consecutiveCount++;
+        chunk->next = manager->segmentChunks;
+        manager->segmentChunks = chunk;
 
-            if (consecutiveCount == numPages)
-            {
-                return startFrame;
-            }
-        }
-        else
+        // Thread the new nodes onto the free list through their next links
+        for (int i = SEGMENT_POOL_CHUNK_NODES - 1; i >= 0; i--)
         {
-            consecutiveCount = 0;
-            startFrame = -1;
+            chunk->nodes[i].next = manager->freeSegmentNodes;
+            manager->freeSegmentNodes = &chunk->nodes[i];
         }
     }
 
-    return -1; // Not enough contiguous pages
+    MemorySegment *segment = manager->freeSegmentNodes;
+    manager->freeSegmentNodes = segment->next;
+    return segment;
 }
 
-// Create a new process
-int createProcess(MemoryManager *manager, const char *name, size_t size)
+// Return a segment node to the manager's pool
+static void releaseSegmentNode(MemoryManager *manager, MemorySegment *segment)
 {
-    if (manager->processCount >= manager->maxProcesses)
+    // An incremental compaction parked on a merged-away node restarts from the head
+    if (manager->compactCursor == segment)
     {
-        error("Cannot create more processes: maximum limit reached");
-        return -1;
+        manager->compactCursor = NULL;
     }
 
-    int processId = manager->processCount;
-    Process *proc = &manager->processes[processId];
-
-    proc->id = processId;
-    strncpy(proc->name, name, 31);
-    proc->name[31] = '\0';
-    proc->size = size;
-    proc->allocStrategy = manager->strategy;
-    proc->segments = NULL;
-    proc->segmentCount = 0;
-    proc->pageTable = NULL;
-
-    bool success = false;
+    segment->next = manager->freeSegmentNodes;
+    manager->freeSegmentNodes = segment;
+}
 
-    switch (manager->strategy)
+// Allocate a free segment node covering [address, address + size)
+static MemorySegment *createFreeSegment(MemoryManager *manager, size_t address, size_t size)
+{
+    MemorySegment *segment = allocSegmentNode(manager);
+    if (!segment)
     {
-    case SEGMENTATION:
-        success = allocateSegment(manager, processId, "process", size);
-        break;
-
-    case PAGING:
-        success = allocatePages(manager, processId, size);
-        break;
-
-    case HYBRID:
-        // In hybrid mode, we'll use segmentation for large allocations and paging for small ones
-        if (size > manager->pageSize * 4)
-        {
-            success = allocateSegment(manager, processId, "process", size);
-        }
-        else
-        {
-            success = allocatePages(manager, processId, size);
-        }
-        break;
+        return NULL;
     }
+    segment->id = 0;
+    segment->size = size;
+    segment->address = address;
+    segment->usedBytes = 0;
+    segment->allocated = false;
+    strcpy(segment->processName, "none");
+    segment->processId = -1;
+    strcpy(segment->segmentType, "free");
+    segment->next = NULL;
+    segment->prev = NULL;
+    segment->nextFree = NULL;
+    segment->prevFree = NULL;
+    segment->treeLeft = NULL;
+    segment->treeRight = NULL;
+    segment->nextInProcess = NULL;
+    return segment;
+}
 
-    if (success)
-    {
-        char logMsg[100];
-        sprintf(logMsg, "Created process %s (ID: %d) with size: %zu bytes", name, processId, size);
-        info(logMsg);
-        manager->processCount++;
-        return processId;
-    }
-    else
+// Insert newSegment directly after segment in address order
+static void linkSegmentAfter(MemorySegment *segment, MemorySegment *newSegment)
+{
+    newSegment->prev = segment;
+    newSegment->next = segment->next;
+    if (segment->next)
     {
-        char logMsg[100];
-        sprintf(logMsg, "Failed to create process %s: not enough memory", name);
-        error(logMsg);
-        return -1;
+        segment->next->prev = newSegment;
     }
+    segment->next = newSegment;
 }
 
-// Terminate a process and free its memory
-bool terminateProcess(MemoryManager *manager, int processId)
+// Remove the segment directly after segment from the address-ordered list
+static MemorySegment *unlinkNextSegment(MemorySegment *segment)
 {
-    if (processId < 0 || processId >= manager->processCount)
+    MemorySegment *removed = segment->next;
+    segment->next = removed->next;
+    if (removed->next)
     {
-        char errMsg[100];
-        sprintf(errMsg, "Invalid process ID when terminating: %d", processId);
-        error(errMsg);
-        return false;
+        removed->next->prev = segment;
     }
+    return removed;
+}
 
-    Process *proc = &manager->processes[processId];
-
-    switch (manager->strategy)
+// Human-readable name of a memory strategy
+const char *memoryStrategyName(MemoryStrategy strategy)
+{
+    switch (strategy)
     {
     case SEGMENTATION:
-        deallocateSegments(manager, processId);
-        break;
-
+        return "Segmentation";
     case PAGING:
-        deallocatePages(manager, processId);
-        break;
-
+        return "Paging";
     case HYBRID:
-        // Free both segment and page allocations
-        deallocateSegments(manager, processId);
-        deallocatePages(manager, processId);
-        break;
+        return "Hybrid";
+    case BUDDY:
+        return "Buddy";
+    case TLSF:
+        return "TLSF";
     }
-
-    char logMsg[100];
-    sprintf(logMsg, "Terminated process %s (ID: %d)", proc->name, processId);
-    info(logMsg);
-
-    return true;
+    return "Unknown";
 }
 
-// Split a segment for allocation
-void splitSegment(MemoryManager *manager, MemorySegment *segment, size_t size, int processId, const char *segmentType)
+// Size class of a free segment: floor(log2(size)), with empty segments in bin 0
+static int segmentBinIndex(size_t size)
 {
-    if (segment->size > size)
-    {
-        // Create a new segment for the remainder
-        MemorySegment *newSegment = (MemorySegment *)malloc(sizeof(MemorySegment));
-        newSegment->id = segment->id + 1;
-        newSegment->size = segment->size - size;
-        newSegment->address = segment->address + size;
-        newSegment->allocated = false;
-        strcpy(newSegment->processName, "none");
-        newSegment->processId = -1;
-        strcpy(newSegment->segmentType, "free");
-
-        // Insert new segment into list
-        newSegment->next = segment->next;
-        segment->next = newSegment;
-    }
-
-    // Update the original segment
-    segment->size = size;
-    segment->allocated = true;
-    strncpy(segment->processName, manager->processes[processId].name, 31);
-    segment->processName[31] = '\0';
-    segment->processId = processId;
-    strncpy(segment->segmentType, segmentType, 15);
-    segment->segmentType[15] = '\0';
-
-    // Update memory stats
-    manager->usedMemory += size;
-    manager->freeMemory -= size;
+    return size > 1 ? highestBit64((uint64_t)size) : 0;
 }
 
-// Allocate a memory segment for a process
-bool allocateSegment(MemoryManager *manager, int processId, const char *segmentType, size_t size)
+// Human-readable name of a placement policy
+const char *placementPolicyName(PlacementPolicy placement)
 {
-    if (processId < 0 || processId > manager->processCount)
+    switch (placement)
     {
-        char errMsg[100];
-        sprintf(errMsg, "Invalid process ID when allocating: %d", processId);
-        error(errMsg);
-        return false;
+    case PLACEMENT_FIRST_FIT:
+        return "First-fit";
+    case PLACEMENT_NEXT_FIT:
+        return "Next-fit";
+    case PLACEMENT_BEST_FIT:
+        return "Best-fit";
+    case PLACEMENT_WORST_FIT:
+        return "Worst-fit";
+    case PLACEMENT_SEGREGATED_FIT:
+        return "Segregated-fit";
     }
+    return "Unknown";
+}
 
-    // Find a suitable free segment
-    MemorySegment *segment = findFreeSegment(manager, size);
-    if (!segment)
+// Get a printable name for a page replacement policy
+const char *replacementPolicyName(ReplacementPolicy policy)
+{
+    switch (policy)
     {
-        char errMsg[100];
-        sprintf(errMsg, "Failed to allocate segment: no suitable free segment of size %zu found", size);
-        error(errMsg);
-        return false;
+    case REPLACEMENT_FIFO:
+        return "FIFO";
+    case REPLACEMENT_LRU:
+        return "LRU";
+    case REPLACEMENT_CLOCK:
+        return "Clock";
+    case REPLACEMENT_ARC:
+        return "ARC";
     }
+    return "Unknown";
+}
 
-    // Split and allocate the segment
-    splitSegment(manager, segment, size, processId, segmentType);
-
-    // Add segment to process
-    Process *proc = &manager->processes[processId];
-    proc->segmentCount++;
-
-    // Create a copy of the segment for the process
-    MemorySegment *procSegment = (MemorySegment *)malloc(sizeof(MemorySegment));
-    memcpy(procSegment, segment, sizeof(MemorySegment));
-    procSegment->next = proc->segments;
-    proc->segments = procSegment;
-
-    char logMsg[100];
-    sprintf(logMsg, "Allocated %s segment of size %zu for process %s at address %zu",
-            segmentType, size, proc->name, segment->address);
-    info(logMsg);
+// Treap priority derived from the segment address so tree shape is deterministic
+static uint64_t segmentTreePriority(const MemorySegment *segment)
+{
+    uint64_t x = (uint64_t)segment->address + 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
 
-    return true;
+// Tree ordering: by size, ties broken by address
+static bool segmentTreeLess(const MemorySegment *a, const MemorySegment *b)
+{
+    return a->size < b->size || (a->size == b->size && a->address < b->address);
 }
 
-// Merge adjacent free segments
-void mergeAdjacentFreeSegments(MemoryManager *manager)
+static MemorySegment *segmentTreeInsert(MemorySegment *root, MemorySegment *node)
 {
-    MemorySegment *current = manager->segmentList;
+    if (!root)
+    {
+        node->treeLeft = NULL;
+        node->treeRight = NULL;
+        return node;
+    }
 
-    while (current && current->next)
+    if (segmentTreeLess(node, root))
     {
-        if (!current->allocated && !current->next->allocated)
+        root->treeLeft = segmentTreeInsert(root->treeLeft, node);
+        if (segmentTreePriority(root->treeLeft) > segmentTreePriority(root))
         {
-            // Merge with next segment
-            MemorySegment *toDelete = current->next;
-            current->size += toDelete->size;
-            current->next = toDelete->next;
-            free(toDelete);
+            // Rotate right
+            MemorySegment *left = root->treeLeft;
+            root->treeLeft = left->treeRight;
+            left->treeRight = root;
+            return left;
         }
-        else
+    }
+    else
+    {
+        root->treeRight = segmentTreeInsert(root->treeRight, node);
+        if (segmentTreePriority(root->treeRight) > segmentTreePriority(root))
         {
-            current = current->next;
+            // Rotate left
+            MemorySegment *right = root->treeRight;
+            root->treeRight = right->treeLeft;
+            right->treeLeft = root;
+            return right;
         }
     }
+
+    return root;
 }
 
-// Free all segments allocated to a process
-void deallocateSegments(MemoryManager *manager, int processId)
+// Join two treaps where every key in left precedes every key in right
+static MemorySegment *segmentTreeJoin(MemorySegment *left, MemorySegment *right)
 {
-    if (processId < 0 || processId > manager->processCount)
+    if (!left)
+        return right;
+    if (!right)
+        return left;
+
+    if (segmentTreePriority(left) > segmentTreePriority(right))
     {
-        return;
+        left->treeRight = segmentTreeJoin(left->treeRight, right);
+        return left;
     }
 
-    // Mark all segments belonging to this process as free
-    MemorySegment *current = manager->segmentList;
-    size_t freedMemory = 0;
+    right->treeLeft = segmentTreeJoin(left, right->treeLeft);
+    return right;
+}
 
-    while (current)
+static MemorySegment *segmentTreeRemove(MemorySegment *root, MemorySegment *node)
+{
+    if (!root)
+        return NULL;
+
+    if (root == node)
     {
-        if (current->allocated && current->processId == processId)
-        {
-            current->allocated = false;
-            strcpy(current->processName, "none");
-            current->processId = -1;
-            strcpy(current->segmentType, "free");
-            freedMemory += current->size;
-        }
-        current = current->next;
+        MemorySegment *joined = segmentTreeJoin(root->treeLeft, root->treeRight);
+        node->treeLeft = NULL;
+        node->treeRight = NULL;
+        return joined;
     }
 
-    // Update memory stats
-    manager->usedMemory -= freedMemory;
-    manager->freeMemory += freedMemory;
-
-    // Free process segments list
-    Process *proc = &manager->processes[processId];
-    MemorySegment *seg = proc->segments;
-    while (seg)
+    if (segmentTreeLess(node, root))
     {
-        MemorySegment *next = seg->next;
-        free(seg);
-        seg = next;
+        root->treeLeft = segmentTreeRemove(root->treeLeft, node);
+    }
+    else
+    {
+        root->treeRight = segmentTreeRemove(root->treeRight, node);
     }
-    proc->segments = NULL;
-    proc->segmentCount = 0;
 
-    // Merge adjacent free segments
-    mergeAdjacentFreeSegments(manager);
+    return root;
+}
 
-    char logMsg[100];
-    sprintf(logMsg, "Deallocated all segments for process %s (ID: %d), freed %zu bytes",
-            proc->name, processId, freedMemory);
-    info(logMsg);
+// Swap two entries of the largest-free-block heap, keeping their back-pointers in sync
+static void freeBlockHeapSwap(MemoryManager *manager, size_t i, size_t j)
+{
+    MemorySegment *tmp = manager->freeBlockHeap[i];
+    manager->freeBlockHeap[i] = manager->freeBlockHeap[j];
+    manager->freeBlockHeap[j] = tmp;
+    manager->freeBlockHeap[i]->heapIndex = i;
+    manager->freeBlockHeap[j]->heapIndex = j;
 }
 
-// Allocate pages for a process
-bool allocatePages(MemoryManager *manager, int processId, size_t size)
+static void freeBlockHeapSiftUp(MemoryManager *manager, size_t i)
 {
-    if (processId < 0 || processId > manager->processCount)
+    while (i > 0)
     {
-        char errMsg[100];
-        sprintf(errMsg, "Invalid process ID when allocating: %d", processId);
-        error(errMsg);
-        return false;
+        size_t parent = (i - 1) / 2;
+        if (manager->freeBlockHeap[parent]->size >= manager->freeBlockHeap[i]->size)
+        {
+            break;
+        }
+        freeBlockHeapSwap(manager, i, parent);
+        i = parent;
+    }
+}
+
+static void freeBlockHeapSiftDown(MemoryManager *manager, size_t i)
+{
+    size_t count = (size_t)manager->freeBlockCount;
+    for (;;)
+    {
+        size_t largest = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        if (left < count && manager->freeBlockHeap[left]->size > manager->freeBlockHeap[largest]->size)
+        {
+            largest = left;
+        }
+        if (right < count && manager->freeBlockHeap[right]->size > manager->freeBlockHeap[largest]->size)
+        {
+            largest = right;
+        }
+        if (largest == i)
+        {
+            break;
+        }
+        freeBlockHeapSwap(manager, i, largest);
+        i = largest;
     }
+}
 
-    Process *proc = &manager->processes[processId];
+// Count a segment/block that has just become free (or been resized while unindexed)
+static void trackFreeBlock(MemoryManager *manager, MemorySegment *segment)
+{
+    // The heap grows with the node pool, so there is always room for every node
+    size_t count = (size_t)manager->freeBlockCount;
+    segment->heapIndex = count;
+    manager->freeBlockHeap[count] = segment;
+    manager->freeBlockCount++;
+    manager->freeBlockBytes += segment->size;
+    freeBlockHeapSiftUp(manager, count);
+}
 
-    // Calculate how many pages are needed
-    size_t numPages = (size + manager->pageSize - 1) / manager->pageSize;
+// Stop counting a free segment/block that is being allocated, merged or resized
+static void untrackFreeBlock(MemoryManager *manager, MemorySegment *segment)
+{
+    size_t i = segment->heapIndex;
+    size_t last = (size_t)--manager->freeBlockCount;
+    manager->freeBlockBytes -= segment->size;
 
-    if (numPages > manager->freePages)
+    if (i != last)
     {
-        char errMsg[100];
-        sprintf(errMsg, "Not enough free pages. Required: %zu, Available: %zu", numPages, manager->freePages);
-        error(errMsg);
-        return false;
+        freeBlockHeapSwap(manager, i, last);
+        freeBlockHeapSiftUp(manager, i);
+        freeBlockHeapSiftDown(manager, i);
     }
+}
 
-    // Allocate page table for the process
-    proc->pageTable = (PageTable *)malloc(sizeof(PageTable));
-    proc->pageTable->processId = processId;
-    proc->pageTable->pageCount = numPages;
-    proc->pageTable->pages = (Page *)malloc(numPages * sizeof(Page));
-
-    // Assign pages using either contiguous or scattered allocation based on availability
-    int startFrame = findFreePages(manager, numPages);
+// Add a free segment to the head of its size-class bin and to the size tree
+static void indexFreeSegment(MemoryManager *manager, MemorySegment *segment)
+{
+    int bin = segmentBinIndex(segment->size);
 
-    if (startFrame >= 0)
+    segment->prevFree = NULL;
+    segment->nextFree = manager->freeBins[bin];
+    if (segment->nextFree)
     {
-        // Contiguous allocation possible
-        for (size_t i = 0; i < numPages; i++)
-        {
-            size_t frameIndex = startFrame + i;
-            Page *frame = &manager->pageFrames[frameIndex];
-            frame->allocated = true;
-            frame->processId = processId;
+        segment->nextFree->prevFree = segment;
+    }
+    manager->freeBins[bin] = segment;
+    manager->freeBinMap |= (uint64_t)1 << bin;
 
-            // Calculate how much of this page is actually used
-            size_t usedInPage = (i == numPages - 1) ? (size % manager->pageSize == 0 ? manager->pageSize : size % manager->pageSize) : manager->pageSize;
+    manager->freeTree = segmentTreeInsert(manager->freeTree, segment);
+    trackFreeBlock(manager, segment);
+}
 
-            frame->usedBytes = usedInPage;
+// Remove a free segment from its size-class bin and from the size tree
+static void unindexFreeSegment(MemoryManager *manager, MemorySegment *segment)
+{
+    int bin = segmentBinIndex(segment->size);
 
-            // Copy page info to process page table
-            memcpy(&proc->pageTable->pages[i], frame, sizeof(Page));
-        }
+    if (segment->prevFree)
+    {
+        segment->prevFree->nextFree = segment->nextFree;
     }
     else
     {
-        // Need to use scattered allocation
-        size_t pageCount = 0;
-
-        for (size_t i = 0; i < manager->totalPages && pageCount < numPages; i++)
+        manager->freeBins[bin] = segment->nextFree;
+        if (!manager->freeBins[bin])
         {
-            if (!manager->pageFrames[i].allocated)
-            {
-                Page *frame = &manager->pageFrames[i];
-                frame->allocated = true;
-                frame->processId = processId;
-
-                // Calculate how much of this page is actually used
-                size_t usedInPage = (pageCount == numPages - 1) ? (size % manager->pageSize == 0 ? manager->pageSize : size % manager->pageSize) : manager->pageSize;
-
-                frame->usedBytes = usedInPage;
-
-                // Copy page info to process page table
-                memcpy(&proc->pageTable->pages[pageCount], frame, sizeof(Page));
-
-                pageCount++;
-            }
+            manager->freeBinMap &= ~((uint64_t)1 << bin);
         }
     }
 
-    // Update memory stats
-    manager->freePages -= numPages;
-    manager->usedMemory += size;
-    manager->freeMemory -= numPages * manager->pageSize;
+    if (segment->nextFree)
+    {
+        segment->nextFree->prevFree = segment->prevFree;
+    }
 
-    char logMsg[100];
-    sprintf(logMsg, "Allocated %zu pages (%zu bytes) for process %s (ID: %d)",
-            numPages, numPages * manager->pageSize, proc->name, processId);
-    info(logMsg);
+    segment->nextFree = NULL;
+    segment->prevFree = NULL;
 
-    return true;
+    manager->freeTree = segmentTreeRemove(manager->freeTree, segment);
+    untrackFreeBlock(manager, segment);
 }
 
-// Free all pages allocated to a process
-void deallocatePages(MemoryManager *manager, int processId)
+// First fit: lowest-address free segment that is large enough
+static MemorySegment *findFirstFit(MemorySegment *start, MemorySegment *end, size_t size)
 {
-    if (processId < 0 || processId > manager->processCount)
+    for (MemorySegment *current = start; current != end; current = current->next)
     {
-        return;
+        if (!current->allocated && current->size >= size)
+        {
+            return current;
+        }
     }
 
-    Process *proc = &manager->processes[processId];
+    return NULL;
+}
 
-    if (!proc->pageTable)
+// First fit from start to the end of memory, reporting the largest free segment passed over on the way
+static MemorySegment *findFirstFitFrom(MemorySegment *start, size_t size, size_t *largestSkipped)
+{
+    for (MemorySegment *current = start; current; current = current->next)
     {
-        return; // No pages allocated
+        if (!current->allocated)
+        {
+            if (current->size >= size)
+            {
+                return current;
+            }
+            if (current->size > *largestSkipped)
+            {
+                *largestSkipped = current->size;
+            }
+        }
     }
 
-    size_t numPages = proc->pageTable->pageCount;
-    size_t freedMemory = 0;
+    return NULL;
+}
 
-    // Free all frames allocated to this process
-    for (size_t i = 0; i < manager->totalPages; i++)
+// Best fit: smallest free segment that is large enough (tree lower bound)
+static MemorySegment *findBestFit(MemoryManager *manager, size_t size)
+{
+    MemorySegment *best = NULL;
+    MemorySegment *current = manager->freeTree;
+
+    while (current)
     {
-        if (manager->pageFrames[i].allocated && manager->pageFrames[i].processId == processId)
+        if (current->size >= size)
+        {
+            best = current;
+            current = current->treeLeft;
+        }
+        else
         {
-            freedMemory += manager->pageFrames[i].usedBytes;
-            manager->pageFrames[i].allocated = false;
-            manager->pageFrames[i].processId = -1;
-            manager->pageFrames[i].usedBytes = 0;
+            current = current->treeRight;
         }
     }
 
-    // Free the page table
-    free(proc->pageTable->pages);
-    free(proc->pageTable);
-    proc->pageTable = NULL;
-
-    // Update memory stats
-    manager->freePages += numPages;
-    manager->usedMemory -= freedMemory;
-    manager->freeMemory += numPages * manager->pageSize;
-
-    char logMsg[100];
-    sprintf(logMsg, "Deallocated %zu pages for process %s (ID: %d), freed %zu bytes",
-            numPages, proc->name, processId, freedMemory);
-    info(logMsg);
+    return best;
 }
 
-// Calculate memory fragmentation statistics
-void calculateFragmentation(MemoryManager *manager)
+// Worst fit: largest free segment (rightmost tree node)
+static MemorySegment *findWorstFit(MemoryManager *manager, size_t size)
 {
-    if (!manager)
-        return;
+    MemorySegment *current = manager->freeTree;
+    if (!current)
+    {
+        return NULL;
+    }
 
-    char header[100];
-    sprintf(header, "======== Fragmentation Analysis ========");
-    info(header);
+    while (current->treeRight)
+    {
+        current = current->treeRight;
+    }
 
-    switch (manager->strategy)
+    return current->size >= size ? current : NULL;
+}
+
+// Find a suitable segment using the manager's placement policy
+MemorySegment *findFreeSegment(MemoryManager *manager, size_t size)
+{
+    switch (manager->placement)
     {
-    case SEGMENTATION:
+    case PLACEMENT_FIRST_FIT:
+        return findFirstFit(manager->segmentList, NULL, size);
+
+    case PLACEMENT_NEXT_FIT:
     {
-        // Calculate external fragmentation
-        size_t totalFreeMemory = 0;
-        size_t largestFreeBlock = 0;
-        int freeBlockCount = 0;
+        // Resume from the roving pointer, wrapping around to the head
+        MemorySegment *cursor = manager->nextFitCursor ? manager->nextFitCursor : manager->segmentList;
+        MemorySegment *found = findFirstFit(cursor, NULL, size);
+        return found ? found : findFirstFit(manager->segmentList, cursor, size);
+    }
 
-        MemorySegment *current = manager->segmentList;
-        while (current)
-        {
-            if (!current->allocated)
-            {
-                totalFreeMemory += current->size;
-                freeBlockCount++;
-                if (current->size > largestFreeBlock)
-                {
-                    largestFreeBlock = current->size;
-                }
-            }
-            current = current->next;
-        }
+    case PLACEMENT_BEST_FIT:
+        return findBestFit(manager, size);
+
+    case PLACEMENT_WORST_FIT:
+        return findWorstFit(manager, size);
 
-        // External fragmentation is measured as 1 - (largest free block / total free memory)
-        if (totalFreeMemory > 0)
+    case PLACEMENT_SEGREGATED_FIT:
+    default:
+        return findSegregatedFit(manager, size);
+    }
+}
+
+// Segregated fit: look up the size-class bins
+static MemorySegment *findSegregatedFit(MemoryManager *manager, size_t size)
+{
+    int bin = segmentBinIndex(size);
+
+    // Exact-fit path: probe the head of the request's own bin, which may
+    // also hold blocks smaller than the request
+    MemorySegment *candidate = NULL;
+    MemorySegment *current = manager->freeBins[bin];
+    for (int probes = 0; current && probes < SEGMENT_BIN_PROBE_LIMIT; probes++)
+    {
+        if (current->size == size)
         {
-            manager->externalFragmentation = 1.0 - ((double)largestFreeBlock / totalFreeMemory);
+            return current;
         }
-        else
+        if (!candidate && current->size >= size)
         {
-            manager->externalFragmentation = 0.0;
+            candidate = current;
         }
+        current = current->nextFree;
+    }
 
-        char logMsg[150];
-        sprintf(logMsg, "Segmentation: External Fragmentation: %.2f%% (Free blocks: %d, Total free: %zu, Largest free: %zu)",
-                manager->externalFragmentation * 100, freeBlockCount, totalFreeMemory, largestFreeBlock);
-        info(logMsg);
-        break;
+    if (candidate)
+    {
+        return candidate;
     }
 
-    case PAGING:
+    // Any block in a larger bin is guaranteed to fit
+    uint64_t largerBins = bin + 1 < SEGMENT_BIN_COUNT ? manager->freeBinMap & (~(uint64_t)0 << (bin + 1)) : 0;
+    if (largerBins)
     {
-        // Calculate internal fragmentation
-        size_t wastedSpace = 0;
-        size_t totalAllocated = 0;
+        return manager->freeBins[lowestBit64(largerBins)];
+    }
 
-        for (size_t i = 0; i < manager->totalPages; i++)
+    // Fall back to the rest of the request's own bin
+    while (current)
+    {
+        if (current->size >= size)
         {
-            if (manager->pageFrames[i].allocated)
-            {
-                wastedSpace += (manager->pageSize - manager->pageFrames[i].usedBytes);
-                totalAllocated += manager->pageSize;
-            }
+            return current;
         }
+        current = current->nextFree;
+    }
 
-        // Internal fragmentation is measured as wasted space / total allocated space
-        if (totalAllocated > 0)
-        {
-            manager->internalFragmentation = (double)wastedSpace / totalAllocated;
-        }
-        else
+    return NULL;
+}
+
+// Bit for the block of the given order that starts at address in that order's free bitmap
+static bool buddyBlockIsFree(MemoryManager *manager, size_t address, int order)
+{
+    size_t index = (address / manager->buddyMinBlock) >> order;
+    return (manager->buddyFreeBitmap[order][index / 64] >> (index % 64)) & 1;
+}
+
+static void buddySetFreeBit(MemoryManager *manager, size_t address, int order, bool isFree)
+{
+    size_t index = (address / manager->buddyMinBlock) >> order;
+    uint64_t mask = (uint64_t)1 << (index % 64);
+
+    if (isFree)
+        manager->buddyFreeBitmap[order][index / 64] |= mask;
+    else
+        manager->buddyFreeBitmap[order][index / 64] &= ~mask;
+}
+
+// Put a block on the free list of its order
+static void buddyPushFree(MemoryManager *manager, MemorySegment *block, int order)
+{
+    block->prevFree = NULL;
+    block->nextFree = manager->buddyFreeLists[order];
+    if (block->nextFree)
+    {
+        block->nextFree->prevFree = block;
+    }
+    manager->buddyFreeLists[order] = block;
+    manager->buddyOrderMap |= (uint64_t)1 << order;
+    buddySetFreeBit(manager, block->address, order, true);
+    trackFreeBlock(manager, block);
+}
+
+// Take a block off the free list of its order
+static void buddyUnlinkFree(MemoryManager *manager, MemorySegment *block, int order)
+{
+    if (block->prevFree)
+    {
+        block->prevFree->nextFree = block->nextFree;
+    }
+    else
+    {
+        manager->buddyFreeLists[order] = block->nextFree;
+        if (!block->nextFree)
         {
-            manager->internalFragmentation = 0.0;
+            manager->buddyOrderMap &= ~((uint64_t)1 << order);
         }
-
-        char logMsg[150];
-        sprintf(logMsg, "Paging: Internal Fragmentation: %.2f%% (Wasted: %zu bytes out of %zu allocated)",
-                manager->internalFragmentation * 100, wastedSpace, totalAllocated);
-        info(logMsg);
-        break;
     }
 
-    case HYBRID:
+    if (block->nextFree)
     {
-        // Calculate both types of fragmentation
+        block->nextFree->prevFree = block->prevFree;
+    }
 
-        // External fragmentation (segmentation)
-        size_t totalFreeMemory = 0;
-        size_t largestFreeBlock = 0;
-        int freeBlockCount = 0;
+    block->nextFree = NULL;
+    block->prevFree = NULL;
+    buddySetFreeBit(manager, block->address, order, false);
+    untrackFreeBlock(manager, block);
+}
 
-        MemorySegment *current = manager->segmentList;
-        while (current)
-        {
-            if (!current->allocated)
-            {
-                totalFreeMemory += current->size;
-                freeBlockCount++;
-                if (current->size > largestFreeBlock)
-                {
-                    largestFreeBlock = current->size;
-                }
-            }
-            current = current->next;
-        }
+// Carve the managed range into maximal aligned free blocks
+static void initBuddyBlocks(MemoryManager *manager)
+{
+    size_t minBlock = manager->buddyMinBlock;
+    size_t blockCount = manager->totalMemory / minBlock;
 
-        if (totalFreeMemory > 0)
-        {
-            manager->externalFragmentation = 1.0 - ((double)largestFreeBlock / totalFreeMemory);
-        }
-        else
-        {
-            manager->externalFragmentation = 0.0;
-        }
+    manager->buddyMaxOrder = blockCount > 0 ? highestBit64((uint64_t)blockCount) : 0;
+    if (manager->buddyMaxOrder >= BUDDY_MAX_ORDERS)
+    {
+        manager->buddyMaxOrder = BUDDY_MAX_ORDERS - 1;
+    }
 
-        // Internal fragmentation (paging)
-        size_t wastedSpace = 0;
-        size_t totalAllocated = 0;
+    // One spare word per order covers the buddy index just past the last whole block
+    for (int order = 0; order <= manager->buddyMaxOrder; order++)
+    {
+        manager->buddyFreeBitmap[order] = (uint64_t *)calloc((blockCount >> order) / 64 + 1, sizeof(uint64_t));
+    }
+    manager->buddyBlockTable = (MemorySegment **)calloc(blockCount > 0 ? blockCount : 1, sizeof(MemorySegment *));
 
-        for (size_t i = 0; i < manager->totalPages; i++)
+    MemorySegment *tail = NULL;
+    size_t index = 0;
+    while (index < blockCount)
+    {
+        int order = index > 0 ? lowestBit64((uint64_t)index) : manager->buddyMaxOrder;
+        if (order > manager->buddyMaxOrder)
         {
-            if (manager->pageFrames[i].allocated)
-            {
-                wastedSpace += (manager->pageSize - manager->pageFrames[i].usedBytes);
-                totalAllocated += manager->pageSize;
-            }
+            order = manager->buddyMaxOrder;
         }
-
-        if (totalAllocated > 0)
+        while (index + ((size_t)1 << order) > blockCount)
         {
-            manager->internalFragmentation = (double)wastedSpace / totalAllocated;
+            order--;
         }
+
+        MemorySegment *block = createFreeSegment(manager, index * minBlock, minBlock << order);
+        block->id = (int)index;
+        if (tail)
+            linkSegmentAfter(tail, block);
         else
-        {
-            manager->internalFragmentation = 0.0;
-        }
+            manager->segmentList = block;
+        tail = block;
 
-        char logMsg[200];
-        sprintf(logMsg, "Hybrid: External Fragmentation: %.2f%%, Internal Fragmentation: %.2f%%",
-                manager->externalFragmentation * 100, manager->internalFragmentation * 100);
-        info(logMsg);
-        break;
+        manager->buddyBlockTable[index] = block;
+        buddyPushFree(manager, block, order);
+        index += (size_t)1 << order;
     }
+
+    // Bytes past the last whole order-0 block are not managed
+    manager->freeMemory = blockCount * minBlock;
+    if (manager->freeMemory < manager->totalMemory)
+    {
+        char logMsg[150];
+        sprintf(logMsg, "Buddy allocator leaves %zu trailing bytes unmanaged (not a multiple of %zu)",
+                manager->totalMemory - manager->freeMemory, minBlock);
+        warn(logMsg);
     }
 }
 
-// Print memory statistics
-void printMemoryStats(MemoryManager *manager)
+// Take a block of at least size bytes, splitting a larger block if needed
+static MemorySegment *buddyAllocateBlock(MemoryManager *manager, size_t size)
 {
-    if (!manager)
-        return;
+    size_t minBlock = manager->buddyMinBlock;
 
-    char header[100];
-    sprintf(header, "======== Memory Manager Statistics ========");
-    info(header);
+    // No block is larger than memory, and rounding a larger size up could wrap
+    if (size > manager->totalMemory)
+    {
+        return NULL;
+    }
 
-    char strategyMsg[100];
-    sprintf(strategyMsg, "Strategy: %s",
-            manager->strategy == SEGMENTATION ? "Segmentation" : manager->strategy == PAGING ? "Paging"
-                                                                                             : "Hybrid");
-    info(strategyMsg);
+    size_t blocksNeeded = (size + minBlock - 1) / minBlock;
+    int order = blocksNeeded > 1 ? highestBit64((uint64_t)blocksNeeded - 1) + 1 : 0;
 
-    char memStats[150];
-    sprintf(memStats, "Total memory: %zu bytes | Used: %zu bytes (%.1f%%) | Free: %zu bytes (%.1f%%)",
-            manager->totalMemory,
-            manager->usedMemory,
-            ((double)manager->usedMemory / manager->totalMemory) * 100,
-            manager->freeMemory,
-            ((double)manager->freeMemory / manager->totalMemory) * 100);
-    info(memStats);
+    if (order > manager->buddyMaxOrder)
+    {
+        return NULL;
+    }
 
-    // Calculate updated fragmentation statistics
-    calculateFragmentation(manager);
+    uint64_t available = manager->buddyOrderMap & (~(uint64_t)0 << order);
+    if (!available)
+    {
+        return NULL;
+    }
 
-    char procHeader[100];
-    sprintf(procHeader, "---- Active Processes: %d ----", manager->processCount);
-    info(procHeader);
+    int current = lowestBit64(available);
+    MemorySegment *block = manager->buddyFreeLists[current];
+    buddyUnlinkFree(manager, block, current);
 
-    for (int i = 0; i < manager->processCount; i++)
+    // Halve the block until it has the requested order, freeing each upper half
+    while (current > order)
     {
-        Process *proc = &manager->processes[i];
-        char procInfo[150];
-        sprintf(procInfo, "Process %d: Name: %s, Size: %zu bytes",
-                proc->id, proc->name, proc->size);
-        info(procInfo);
+        current--;
+        size_t half = minBlock << current;
 
-        switch (manager->strategy)
+        MemorySegment *upper = createFreeSegment(manager, block->address + half, half);
+        if (!upper)
         {
-        case SEGMENTATION:
-            // Print segment information
-            info("  Segments:");
-            MemorySegment *seg = proc->segments;
-            while (seg)
-            {
-                char segInfo[150];
-                sprintf(segInfo, "  - %s segment: Address: %zu, Size: %zu bytes",
-                        seg->segmentType, seg->address, seg->size);
-                info(segInfo);
-                seg = seg->next;
-            }
-            break;
+            // No node for the upper half: hand back the block at the order it still has
+            buddyPushFree(manager, block, current + 1);
+            return NULL;
+        }
+        upper->id = (int)(upper->address / minBlock);
+        linkSegmentAfter(block, upper);
+        block->size = half;
 
-        case PAGING:
-            // Print page table information
-            if (proc->pageTable)
-            {
-                char pageInfo[150];
-                sprintf(pageInfo, "  Pages: %d pages (%zu bytes per page)",
-                        proc->pageTable->pageCount, manager->pageSize);
-                info(pageInfo);
-            }
-            break;
+        manager->buddyBlockTable[upper->address / minBlock] = upper;
+        buddyPushFree(manager, upper, current);
+    }
 
-        case HYBRID:
-            // Print both segment and page information
-            MemorySegment *hybridSeg = proc->segments;
-            if (hybridSeg)
-            {
-                info("  Segments:");
-                while (hybridSeg)
-                {
-                    char segInfo[150];
-                    sprintf(segInfo, "  - %s segment: Address: %zu, Size: %zu bytes",
-                            hybridSeg->segmentType, hybridSeg->address, hybridSeg->size);
-                    info(segInfo);
-                    hybridSeg = hybridSeg->next;
-                }
-            }
+    return block;
+}
 
-            if (proc->pageTable)
-            {
-                char pageInfo[150];
-                sprintf(pageInfo, "  Pages: %d pages (%zu bytes per page)",
-                        proc->pageTable->pageCount, manager->pageSize);
-                info(pageInfo);
-            }
+// Return a free block to the allocator, coalescing with its buddy at each order
+static void buddyReleaseBlock(MemoryManager *manager, MemorySegment *block)
+{
+    size_t minBlock = manager->buddyMinBlock;
+    int order = highestBit64((uint64_t)(block->size / minBlock));
+
+    while (order < manager->buddyMaxOrder)
+    {
+        size_t buddyAddress = block->address ^ (minBlock << order);
+        if (!buddyBlockIsFree(manager, buddyAddress, order))
+        {
             break;
         }
+
+        MemorySegment *buddy = manager->buddyBlockTable[buddyAddress / minBlock];
+        buddyUnlinkFree(manager, buddy, order);
+
+        // Buddies are adjacent, so the upper block directly follows the lower one
+        MemorySegment *lower = buddy->address < block->address ? buddy : block;
+        MemorySegment *upper = lower == buddy ? block : buddy;
+        lower->size <<= 1;
+        unlinkNextSegment(lower);
+        manager->buddyBlockTable[upper->address / minBlock] = NULL;
+        releaseSegmentNode(manager, upper);
+
+        block = lower;
+        order++;
     }
 
-    char footer[100];
-    sprintf(footer, "==========================================");
-    info(footer);
+    buddyPushFree(manager, block, order);
 }
 
-// Visualize the memory layout
-void visualizeMemory(MemoryManager *manager)
+// Map a block size to its TLSF first-level (power of two) and second-level (linear) class
+static void tlsfMapping(size_t size, int *fl, int *sl)
 {
-    if (!manager)
-        return;
-
-    char header[100];
-    sprintf(header, "======== Memory Visualization ========");
-    info(header);
-
-    switch (manager->strategy)
+    if (size < TLSF_SMALL_BLOCK)
     {
-    case SEGMENTATION:
+        *fl = 0;
+        *sl = (int)(size / (TLSF_SMALL_BLOCK / TLSF_SL_COUNT));
+    }
+    else
     {
-        info("Memory Layout (Segmentation):");
-        info("| Address | Size     | Status    | Process   | Type     |");
-        info("|---------|----------|-----------|-----------|----------|");
+        int bit = highestBit64((uint64_t)size);
+        *sl = (int)((size >> (bit - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT);
+        *fl = bit - (TLSF_FL_SHIFT - 1);
+    }
+}
 
-        MemorySegment *current = manager->segmentList;
-        while (current)
-        {
-            char segmentInfo[100];
-            sprintf(segmentInfo, "| %-7zu | %-8zu | %-9s | %-9s | %-8s |",
-                    current->address,
-                    current->size,
-                    current->allocated ? "Allocated" : "Free",
-                    current->allocated ? current->processName : "-",
-                    current->allocated ? current->segmentType : "-");
-            info(segmentInfo);
+// Put a free block on the list for its size class
+static void tlsfInsertFree(MemoryManager *manager, MemorySegment *block)
+{
+    int fl, sl;
+    tlsfMapping(block->size, &fl, &sl);
 
-            current = current->next;
-        }
-        break;
+    block->prevFree = NULL;
+    block->nextFree = manager->tlsfFreeLists[fl][sl];
+    if (block->nextFree)
+    {
+        block->nextFree->prevFree = block;
     }
+    manager->tlsfFreeLists[fl][sl] = block;
 
-    case PAGING:
-    {
-        info("Memory Layout (Paging):");
-        info("| Frame # | Status    | Process   | Used Bytes |");
-        info("|---------|-----------|-----------|------------|");
+    manager->tlsfSlBitmap[fl] |= (uint32_t)1 << sl;
+    manager->tlsfFlBitmap |= (uint64_t)1 << fl;
+    trackFreeBlock(manager, block);
+}
 
-        for (size_t i = 0; i < manager->totalPages; i++)
+// Take a free block off the list for its size class
+static void tlsfRemoveFree(MemoryManager *manager, MemorySegment *block)
+{
+    int fl, sl;
+    tlsfMapping(block->size, &fl, &sl);
+
+    if (block->prevFree)
+    {
+        block->prevFree->nextFree = block->nextFree;
+    }
+    else
+    {
+        manager->tlsfFreeLists[fl][sl] = block->nextFree;
+        if (!block->nextFree)
         {
-            char frameInfo[100];
-            sprintf(frameInfo, "| %-7zu | %-9s | %-9s | %-10zu |",
-                    i,
-                    manager->pageFrames[i].allocated ? "Allocated" : "Free",
-                    manager->pageFrames[i].allocated ? manager->processes[manager->pageFrames[i].processId].name : "-",
-                    manager->pageFrames[i].allocated ? manager->pageFrames[i].usedBytes : 0);
-            info(frameInfo);
+            manager->tlsfSlBitmap[fl] &= ~((uint32_t)1 << sl);
+            if (!manager->tlsfSlBitmap[fl])
+            {
+                manager->tlsfFlBitmap &= ~((uint64_t)1 << fl);
+            }
         }
-        break;
     }
 
-    case HYBRID:
+    if (block->nextFree)
     {
-        info("Memory Layout (Hybrid - Segments):");
-        info("| Address | Size     | Status    | Process   | Type     |");
-        info("|---------|----------|-----------|-----------|----------|");
+        block->nextFree->prevFree = block->prevFree;
+    }
 
-        MemorySegment *current = manager->segmentList;
-        while (current)
-        {
-            char segmentInfo[100];
-            sprintf(segmentInfo, "| %-7zu | %-8zu | %-9s | %-9s | %-8s |",
-                    current->address,
-                    current->size,
-                    current->allocated ? "Allocated" : "Free",
-                    current->allocated ? current->processName : "-",
-                    current->allocated ? current->segmentType : "-");
-            info(segmentInfo);
+    block->nextFree = NULL;
+    block->prevFree = NULL;
+    untrackFreeBlock(manager, block);
+}
 
-            current = current->next;
-        }
+// Find a free block of at least size bytes with two bitmap lookups
+static MemorySegment *tlsfFindSuitable(MemoryManager *manager, size_t size)
+{
+    int fl, sl;
 
-        info("\nMemory Layout (Hybrid - Pages):");
-        info("| Frame # | Status    | Process   | Used Bytes |");
-        info("|---------|-----------|-----------|------------|");
+    // Round up to the next class boundary so any block in the chosen list fits
+    size_t rounded = size;
+    if (rounded >= TLSF_SMALL_BLOCK)
+    {
+        rounded += ((size_t)1 << (highestBit64((uint64_t)rounded) - TLSF_SL_LOG2)) - 1;
+    }
+    tlsfMapping(rounded, &fl, &sl);
 
-        for (size_t i = 0; i < manager->totalPages; i++)
+    uint32_t slMap = fl < TLSF_FL_COUNT ? manager->tlsfSlBitmap[fl] & (~(uint32_t)0 << sl) : 0;
+    if (!slMap)
+    {
+        uint64_t flMap = fl + 1 < TLSF_FL_COUNT ? manager->tlsfFlBitmap & (~(uint64_t)0 << (fl + 1)) : 0;
+        if (flMap)
         {
-            char frameInfo[100];
-            sprintf(frameInfo, "| %-7zu | %-9s | %-9s | %-10zu |",
-                    i,
-                    manager->pageFrames[i].allocated ? "Allocated" : "Free",
-                    manager->pageFrames[i].allocated ? manager->processes[manager->pageFrames[i].processId].name : "-",
-                    manager->pageFrames[i].allocated ? manager->pageFrames[i].usedBytes : 0);
-            info(frameInfo);
+            fl = lowestBit64(flMap);
+            slMap = manager->tlsfSlBitmap[fl];
         }
-        break;
     }
+
+    if (slMap)
+    {
+        return manager->tlsfFreeLists[fl][lowestBit64(slMap)];
     }
 
-    char footer[100];
-    sprintf(footer, "=====================================");
-    info(footer);
+    // Larger classes are empty; the head of the request's own class may still fit
+    tlsfMapping(size, &fl, &sl);
+    MemorySegment *head = manager->tlsfFreeLists[fl][sl];
+    return head && head->size >= size ? head : NULL;
 }
 
-// Visualize the memory layout with a graphical representation
-void visualizeMemoryGraphically(MemoryManager *manager)
+// Take a block of at least size bytes, returning any usable tail to the free lists
+static MemorySegment *tlsfAllocateBlock(MemoryManager *manager, size_t size)
 {
-    if (!manager)
-        return;
-
-    char header[100];
-    sprintf(header, "======== Memory Visualization (Graphical) ========");
-    info(header);
-
-    // Define the display width for visualization
-    const int displayWidth = 80;
-    char visualLine[81];
-
-    switch (manager->strategy)
+    // No block is larger than memory, and aligning a larger size up could wrap
+    if (size > manager->totalMemory)
     {
-    case SEGMENTATION:
+        return NULL;
+    }
+
+    size_t alignMask = ((size_t)1 << TLSF_ALIGN_LOG2) - 1;
+    size_t adjusted = (size + alignMask) & ~alignMask;
+    if (adjusted < TLSF_MIN_BLOCK)
     {
-        info("Memory Layout (Segmentation):");
-        info("Each character represents a memory unit");
-        info("Legend: # = Allocated, . = Free");
+        adjusted = TLSF_MIN_BLOCK;
+    }
 
-        // Count total memory units to scale properly
-        size_t totalMemSize = manager->totalMemory;
-        double scaleFactor = (double)displayWidth / totalMemSize;
+    MemorySegment *block = tlsfFindSuitable(manager, adjusted);
+    if (!block)
+    {
+        return NULL;
+    }
 
-        // Initialize the display
-        for (int i = 0; i < displayWidth; i++)
-            visualLine[i] = ' ';
-        visualLine[displayWidth] = '\0';
+    tlsfRemoveFree(manager, block);
 
-        // Fill in segments
-        MemorySegment *current = manager->segmentList;
-        while (current)
+    if (block->size - adjusted >= TLSF_MIN_BLOCK)
+    {
+        MemorySegment *remainder = createFreeSegment(manager, block->address + adjusted, block->size - adjusted);
+        if (!remainder)
         {
-            int startPos = (int)(current->address * scaleFactor);
-            int endPos = (int)((current->address + current->size) * scaleFactor);
+            tlsfInsertFree(manager, block);
+            return NULL;
+        }
+        linkSegmentAfter(block, remainder);
+        block->size = adjusted;
+        tlsfInsertFree(manager, remainder);
+    }
 
-            // Ensure we don't overflow the buffer
-            if (startPos >= displayWidth)
-                startPos = displayWidth - 1;
-            endPos = (endPos >= displayWidth) ? displayWidth - 1 : endPos;
+    return block;
+}
 
-            char blockChar = current->allocated ? '#' : '.';
+// Return a block to the free lists, merging it with free physical neighbours
+static MemorySegment *tlsfReleaseBlock(MemoryManager *manager, MemorySegment *block)
+{
+    MemorySegment *prev = block->prev;
+    if (prev && !prev->allocated)
+    {
+        tlsfRemoveFree(manager, prev);
+        prev->size += block->size;
+        unlinkNextSegment(prev);
+        releaseSegmentNode(manager, block);
+        block = prev;
+    }
 
-            for (int i = startPos; i <= endPos && i < displayWidth; i++)
-                visualLine[i] = blockChar;
+    MemorySegment *next = block->next;
+    if (next && !next->allocated)
+    {
+        tlsfRemoveFree(manager, next);
+        block->size += next->size;
+        unlinkNextSegment(block);
+        releaseSegmentNode(manager, next);
+    }
 
-            current = current->next;
-        }
+    tlsfInsertFree(manager, block);
+    return block;
+}
 
-        // Print memory visualization
-        info(visualLine);
+// Allocate the frame table and its allocation bitmap, with every frame free
+static void initPageFrames(MemoryManager *manager)
+{
+    manager->pageFrames = (Page *)malloc(manager->totalPages * sizeof(Page));
+    for (size_t i = 0; i < manager->totalPages; i++)
+    {
+        manager->pageFrames[i].id = i;
+        manager->pageFrames[i].frameNumber = i;
+        manager->pageFrames[i].allocated = false;
+        manager->pageFrames[i].processId = -1;
+        manager->pageFrames[i].usedBytes = 0;
+        manager->pageFrames[i].slab = NULL;
+        manager->pageFrames[i].huge = false;
+        manager->pageFrames[i].refCount = 0;
+        manager->pageFrames[i].readOnly = false;
+        manager->pageFrames[i].dirty = false;
+        manager->pageFrames[i].referenced = false;
+        manager->pageFrames[i].residency = RESIDENCY_NONE;
+        manager->pageFrames[i].listPrev = NULL;
+        manager->pageFrames[i].listNext = NULL;
+        manager->pageFrames[i].swapSlot = SWAP_NO_SLOT;
+        manager->pageFrames[i].prefetched = false;
+    }
 
-        // Show markers for addresses
-        info("0                                                                              100%%");
+    // Bits past the last frame are marked allocated so searches never return them
+    size_t words = manager->totalPages / 64 + 1;
+    manager->frameBitmap = (uint64_t *)calloc(words, sizeof(uint64_t));
+    if (manager->totalPages % 64)
+    {
+        manager->frameBitmap[words - 1] = ~(uint64_t)0 << (manager->totalPages % 64);
+    }
+    else
+    {
+        manager->frameBitmap[words - 1] = ~(uint64_t)0;
+    }
+}
 
-        // Show process labels beneath the visualization
-        current = manager->segmentList;
-        while (current)
-        {
-            if (current->allocated)
-            {
-                // Calculate position for the label
-                int labelPos = (int)(current->address * scaleFactor);
-                int labelEndPos = (int)((current->address + current->size) * scaleFactor);
-                int centerPos = (labelPos + labelEndPos) / 2;
+// Mark a frame allocated or free in both the frame table and the bitmap
+void setFrameAllocated(MemoryManager *manager, size_t frameNumber, bool allocated)
+{
+    uint64_t mask = (uint64_t)1 << (frameNumber % 64);
 
-                // Don't print if segment is too small
-                if (labelEndPos - labelPos > 3)
-                {
-                    // Create a label line
-                    for (int i = 0; i < displayWidth; i++)
-                        visualLine[i] = ' ';
+    manager->pageFrames[frameNumber].allocated = allocated;
+    if (allocated)
+        manager->frameBitmap[frameNumber / 64] |= mask;
+    else
+        manager->frameBitmap[frameNumber / 64] &= ~mask;
+}
 
-                    // Place the process name at the center position
-                    int nameLen = strlen(current->processName);
-                    int startNamePos = centerPos - nameLen / 2;
+// First frame at or after start whose allocation bit equals allocated, or totalPages if none
+static size_t findNextFrame(MemoryManager *manager, size_t start, bool allocated)
+{
+    if (start >= manager->totalPages)
+    {
+        return manager->totalPages;
+    }
 
-                    // Make sure we stay within bounds
-                    if (startNamePos < 0)
-                        startNamePos = 0;
-                    if (startNamePos + nameLen >= displayWidth)
-                        startNamePos = displayWidth - nameLen - 1;
+    size_t wordCount = manager->totalPages / 64 + 1;
+    size_t word = start / 64;
 
-                    // Insert the process name
-                    for (int i = 0; i < nameLen && startNamePos + i < displayWidth; i++)
-                        visualLine[startNamePos + i] = current->processName[i];
+    // Flip the words when looking for free frames so the target state is always a set bit
+    uint64_t bits = allocated ? manager->frameBitmap[word] : ~manager->frameBitmap[word];
+    bits &= ~(uint64_t)0 << (start % 64);
 
-                    info(visualLine);
-                }
-            }
-            current = current->next;
+    while (!bits)
+    {
+        if (++word >= wordCount)
+        {
+            return manager->totalPages;
         }
-        break;
+        bits = allocated ? manager->frameBitmap[word] : ~manager->frameBitmap[word];
     }
 
-    case PAGING:
-    {
-        info("Memory Layout (Paging):");
-        info("Each character represents a page frame");
-        info("Legend: # = Allocated, . = Free");
+    size_t frame = word * 64 + lowestBit64(bits);
+    return frame < manager->totalPages ? frame : manager->totalPages;
+}
 
-        // Initialize the display
-        int totalPages = manager->totalPages;
-        int pagesPerRow = displayWidth;
+// Find the first free frame at or after start, or -1 if there is none
+long findFreeFrame(MemoryManager *manager, size_t start)
+{
+    size_t frame = findNextFrame(manager, start, false);
+    return frame < manager->totalPages ? (long)frame : -1;
+}
 
-        // If we have more pages than can fit in one row
-        if (totalPages > displayWidth)
-            pagesPerRow = displayWidth;
+// Find contiguous free pages by hopping between free and allocated runs a word at a time
+int findFreePages(MemoryManager *manager, size_t numPages)
+{
+    return findFreePagesAligned(manager, numPages, 1);
+}
 
-        int rowCount = (totalPages + pagesPerRow - 1) / pagesPerRow;
+// Find contiguous free pages starting at a multiple of alignPages (any aligned fit lies inside one free run)
+int findFreePagesAligned(MemoryManager *manager, size_t numPages, size_t alignPages)
+{
+    return (int)findFreeRun(manager, 0, numPages, alignPages, NULL);
+}
 
-        for (int row = 0; row < rowCount; row++)
-        {
-            // Initialize the line
-            for (int i = 0; i < displayWidth; i++)
-                visualLine[i] = ' ';
-            visualLine[displayWidth] = '\0';
+// Aligned fit of numPages free frames at or after position, or -1; longestSkipped (optional) is raised to the
+// length of every free run passed over
+static long findFreeRun(MemoryManager *manager, size_t position, size_t numPages, size_t alignPages,
+                        size_t *longestSkipped)
+{
+    if (numPages == 0 || alignPages == 0)
+    {
+        return -1;
+    }
 
-            // Fill the line with page frames
-            for (int i = 0; i < pagesPerRow && (row * pagesPerRow + i) < totalPages; i++)
-            {
-                size_t pageNum = row * pagesPerRow + i;
-                visualLine[i] = manager->pageFrames[pageNum].allocated ? '#' : '.';
-            }
+    while (position < manager->totalPages)
+    {
+        size_t runStart = findNextFrame(manager, position, false);
+        if (runStart >= manager->totalPages)
+        {
+            break;
+        }
 
-            info(visualLine);
+        size_t runEnd = findNextFrame(manager, runStart, true);
+        size_t alignedStart = (runStart + alignPages - 1) / alignPages * alignPages;
+        if (alignedStart < runEnd && runEnd - alignedStart >= numPages)
+        {
+            return (long)alignedStart;
+        }
+        if (longestSkipped && runEnd - runStart > *longestSkipped)
+        {
+            *longestSkipped = runEnd - runStart;
         }
+        position = runEnd;
+    }
 
-        // Show process labels beneath the visualization
-        info("Process Ownership:");
+    return -1; // Not enough contiguous pages
+}
 
-        for (int i = 0; i < manager->processCount; i++)
+// Number of free, aligned runs of runPages frames (each could back one page of that size)
+static size_t countFreeAlignedRuns(MemoryManager *manager, size_t runPages)
+{
+    size_t runs = 0;
+    size_t position = 0;
+    while (position < manager->totalPages)
+    {
+        // Every whole aligned run between here and the next allocated frame is free
+        size_t allocated = findNextFrame(manager, position, true);
+        if (allocated > position)
+        {
+            runs += (allocated - position) / runPages;
+        }
+
+        // Resume at the first aligned frame after the next free frame
+        size_t nextFree = findNextFrame(manager, allocated, false);
+        position = (nextFree + runPages - 1) / runPages * runPages;
+    }
+
+    return runs;
+}
+
+// Take a process slot: the most recently released one, or a new one at the end of the table
+static int acquireProcessSlot(MemoryManager *manager)
+{
+    if (manager->freeProcessSlotCount > 0)
+    {
+        return manager->freeProcessSlots[--manager->freeProcessSlotCount];
+    }
+
+    if (manager->processSlots == manager->processCapacity)
+    {
+        int newCapacity = manager->processCapacity * 2;
+        if (newCapacity > manager->maxProcesses)
+        {
+            newCapacity = manager->maxProcesses;
+        }
+
+        Process *newProcesses = (Process *)realloc(manager->processes, newCapacity * sizeof(Process));
+        if (!newProcesses)
+        {
+            error("Failed to grow the process table");
+            return -1;
+        }
+        manager->processes = newProcesses;
+
+        int *newFreeSlots = (int *)realloc(manager->freeProcessSlots, newCapacity * sizeof(int));
+        if (!newFreeSlots)
+        {
+            error("Failed to grow the process table");
+            return -1;
+        }
+        manager->freeProcessSlots = newFreeSlots;
+        manager->processCapacity = newCapacity;
+    }
+
+    int slot = manager->processSlots++;
+    manager->processes[slot].state = PROCESS_FREE;
+    manager->processes[slot].generation = 0;
+    return slot;
+}
+
+// Return a slot to the free-slot stack; bumping the generation retires ids issued for it
+static void releaseProcessSlot(MemoryManager *manager, int slot, bool retireId)
+{
+    Process *proc = &manager->processes[slot];
+    proc->state = PROCESS_FREE;
+    if (retireId)
+    {
+        proc->generation = (proc->generation + 1) & PROCESS_GENERATION_MASK;
+    }
+    manager->freeProcessSlots[manager->freeProcessSlotCount++] = slot;
+}
+
+// Free every segment and page a process holds
+static void releaseProcessMemory(MemoryManager *manager, int processId)
+{
+    switch (manager->strategy)
+    {
+    case SEGMENTATION:
+    case BUDDY:
+    case TLSF:
+        deallocateSegments(manager, processId);
+        break;
+
+    case PAGING:
+        deallocatePages(manager, processId);
+        break;
+
+    case HYBRID:
+        // Free both segment and page allocations
+        deallocateSegments(manager, processId);
+        deallocatePages(manager, processId);
+        break;
+    }
+}
+
+// Look up a live process by id
+Process *getProcess(MemoryManager *manager, int processId)
+{
+    if (processId < 0 || PROCESS_SLOT(processId) >= manager->processSlots)
+    {
+        return NULL;
+    }
+
+    Process *proc = &manager->processes[PROCESS_SLOT(processId)];
+    if (proc->state == PROCESS_FREE || proc->id != processId)
+    {
+        return NULL; // Terminated, or an id from an earlier generation of the slot
+    }
+
+    return proc;
+}
+
+// Create a new process
+int createProcess(MemoryManager *manager, const char *name, size_t size)
+{
+    if (manager->processCount >= manager->maxProcesses)
+    {
+        error("Cannot create more processes: maximum limit reached");
+        return -1;
+    }
+
+    int slot = acquireProcessSlot(manager);
+    if (slot < 0)
+    {
+        return -1;
+    }
+
+    Process *proc = &manager->processes[slot];
+    int processId = (int)(proc->generation << PROCESS_SLOT_BITS) | slot;
+
+    if (manager->trace)
+    {
+        traceRecord(manager->trace, TRACE_CREATE, processId, size, false, name);
+    }
+
+    proc->id = processId;
+    proc->state = PROCESS_STARTING;
+    strncpy(proc->name, name, 31);
+    proc->name[31] = '\0';
+    proc->size = size;
+    proc->allocStrategy = manager->strategy;
+    proc->segments = NULL;
+    proc->segmentCount = 0;
+    proc->pageTable = NULL;
+
+    bool success = false;
+
+    switch (manager->strategy)
+    {
+    case SEGMENTATION:
+    case BUDDY:
+    case TLSF:
+        success = allocateSegment(manager, processId, "process", size);
+        break;
+
+    case PAGING:
+        success = allocatePages(manager, processId, size);
+        break;
+
+    case HYBRID:
+        // In hybrid mode, we'll use segmentation for large allocations and paging for small ones
+        if (size > manager->pageSize * 4)
+        {
+            success = allocateSegment(manager, processId, "process", size);
+        }
+        else
+        {
+            success = allocatePages(manager, processId, size);
+        }
+        break;
+    }
+
+    if (success)
+    {
+        char logMsg[100];
+        sprintf(logMsg, "Created process %s (ID: %d) with size: %zu bytes", name, processId, size);
+        info(logMsg);
+        proc->state = PROCESS_RUNNING;
+        manager->processCount++;
+        return processId;
+    }
+    else
+    {
+        char logMsg[100];
+        sprintf(logMsg, "Failed to create process %s: not enough memory", name);
+        error(logMsg);
+
+        // Hybrid creation may fail after part of it was placed; the id was never handed out
+        if (proc->segments || proc->pageTable)
+        {
+            releaseProcessMemory(manager, processId);
+        }
+        releaseProcessSlot(manager, slot, false);
+        return -1;
+    }
+}
+
+// Terminate a process and free its memory
+bool terminateProcess(MemoryManager *manager, int processId)
+{
+    Process *proc = getProcess(manager, processId);
+    if (!proc)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Invalid process ID when terminating: %d", processId);
+        error(errMsg);
+        return false;
+    }
+
+    if (manager->trace)
+    {
+        traceRecord(manager->trace, TRACE_TERMINATE, processId, 0, false, NULL);
+    }
+
+    releaseProcessMemory(manager, processId);
+
+    char logMsg[100];
+    sprintf(logMsg, "Terminated process %s (ID: %d)", proc->name, processId);
+    info(logMsg);
+
+    releaseProcessSlot(manager, PROCESS_SLOT(processId), true);
+    manager->processCount--;
+
+    return true;
+}
+
+// Record a process as the owner of a segment, of which size bytes are in use
+static void setSegmentOwner(MemoryManager *manager, MemorySegment *segment, size_t size, int processId, const char *segmentType)
+{
+    segment->allocated = true;
+    segment->usedBytes = size;
+    strncpy(segment->processName, manager->processes[PROCESS_SLOT(processId)].name, 31);
+    segment->processName[31] = '\0';
+    segment->processId = processId;
+    strncpy(segment->segmentType, segmentType, 15);
+    segment->segmentType[15] = '\0';
+}
+
+// Mark a segment as owned by a process, of which size bytes are in use
+static void claimSegment(MemoryManager *manager, MemorySegment *segment, size_t size, int processId, const char *segmentType)
+{
+    setSegmentOwner(manager, segment, size, processId, segmentType);
+
+    // Update memory stats
+    manager->usedMemory += size;
+    manager->freeMemory -= segment->size;
+    manager->allocatedBlockBytes += segment->size;
+    manager->wastedBlockBytes += segment->size - size;
+}
+
+// Clear the owner of a segment that is being freed
+static void releaseSegmentOwnership(MemoryManager *manager, MemorySegment *segment)
+{
+    manager->allocatedBlockBytes -= segment->size;
+    manager->wastedBlockBytes -= segment->size - segment->usedBytes;
+
+    segment->allocated = false;
+    segment->usedBytes = 0;
+    strcpy(segment->processName, "none");
+    segment->processId = -1;
+    strcpy(segment->segmentType, "free");
+    segment->nextInProcess = NULL;
+}
+
+// Take a free segment out of the free structures and cut it down to size bytes
+static bool carveSegment(MemoryManager *manager, MemorySegment *segment, size_t size)
+{
+    unindexFreeSegment(manager, segment);
+
+    if (segment->size > size)
+    {
+        // Create a new segment for the remainder
+        MemorySegment *newSegment = createFreeSegment(manager, segment->address + size, segment->size - size);
+        if (!newSegment)
+        {
+            // Leave the segment whole and free
+            indexFreeSegment(manager, segment);
+            return false;
+        }
+        newSegment->id = segment->id + 1;
+
+        // Insert new segment into list
+        linkSegmentAfter(segment, newSegment);
+        indexFreeSegment(manager, newSegment);
+    }
+
+    // Update the original segment
+    segment->size = size;
+    return true;
+}
+
+// Split a segment for allocation
+bool splitSegment(MemoryManager *manager, MemorySegment *segment, size_t size, int processId, const char *segmentType)
+{
+    if (!carveSegment(manager, segment, size))
+    {
+        return false;
+    }
+    claimSegment(manager, segment, size, processId, segmentType);
+    return true;
+}
+
+// Allocate a memory segment for a process
+bool allocateSegment(MemoryManager *manager, int processId, const char *segmentType, size_t size)
+{
+    Process *proc = getProcess(manager, processId);
+    if (!proc)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Invalid process ID when allocating: %d", processId);
+        error(errMsg);
+        return false;
+    }
+
+    if (size == 0)
+    {
+        error("Failed to allocate segment: size must be greater than zero");
+        return false;
+    }
+
+    // Only growth of a live process is an event of its own; createProcess records its initial allocation
+    if (manager->trace && proc->state == PROCESS_RUNNING)
+    {
+        traceRecord(manager->trace, TRACE_ALLOCATE, processId, size, false, NULL);
+    }
+
+    // Find a suitable free segment
+    MemorySegment *segment;
+    switch (manager->strategy)
+    {
+    case BUDDY:
+        segment = buddyAllocateBlock(manager, size);
+        break;
+    case TLSF:
+        segment = tlsfAllocateBlock(manager, size);
+        break;
+    default:
+        segment = findFreeSegment(manager, size);
+        if (!segment && manager->compactOnFailure && manager->freeBlockBytes >= size)
+        {
+            // Enough free memory overall, just not in one hole: squeeze the holes together and retry
+            compactMemory(manager);
+            segment = findFreeSegment(manager, size);
+        }
+        break;
+    }
+
+    if (!segment)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Failed to allocate segment: no suitable free segment of size %zu found", size);
+        error(errMsg);
+        return false;
+    }
+
+    if (manager->strategy == BUDDY || manager->strategy == TLSF)
+    {
+        // The block has already been sized (and split) by the allocator
+        claimSegment(manager, segment, size, processId, segmentType);
+    }
+    else
+    {
+        // Split and allocate the segment
+        if (!splitSegment(manager, segment, size, processId, segmentType))
+        {
+            char errMsg[100];
+            sprintf(errMsg, "Failed to allocate segment: no segment node left to split off %zu bytes", size);
+            error(errMsg);
+            return false;
+        }
+        manager->nextFitCursor = segment->next;
+    }
+
+    // Add segment to process
+    proc->segmentCount++;
+
+    // Link the segment itself into the process's ownership list
+    segment->nextInProcess = proc->segments;
+    proc->segments = segment;
+
+    char logMsg[100];
+    sprintf(logMsg, "Allocated %s segment of size %zu for process %s at address %zu",
+            segmentType, size, proc->name, segment->address);
+    info(logMsg);
+
+    return true;
+}
+
+// Free segment for one request of a batch. First fit resumes from *start: every free segment before it holds at
+// most *skipped bytes, so a larger request cannot land there (holes only shrink while a batch is placed)
+static MemorySegment *findBatchSegment(MemoryManager *manager, size_t size, MemorySegment **start, size_t *skipped)
+{
+    if (manager->placement != PLACEMENT_FIRST_FIT || !*start)
+    {
+        return findFreeSegment(manager, size);
+    }
+
+    size_t largest = 0;
+    if (size > *skipped)
+    {
+        MemorySegment *found = findFirstFitFrom(*start, size, &largest);
+        if (found)
+        {
+            *start = found;
+            *skipped = largest > *skipped ? largest : *skipped;
+        }
+        return found;
+    }
+
+    // Small enough for a hole already passed over: search from the head like a single allocation
+    MemorySegment *found = findFirstFitFrom(manager->segmentList, size, &largest);
+    if (found && found->address >= (*start)->address)
+    {
+        *start = found;
+    }
+    return found;
+}
+
+// Allocate segments for a batch of requests in one pass over the free structures
+int allocateSegmentsBatch(MemoryManager *manager, const AllocationRequest *requests, int count, const char *segmentType,
+                          bool *satisfied)
+{
+    MemorySegment *firstFitStart = manager->segmentList;
+    size_t firstFitSkipped = 0;
+    size_t usedBytes = 0;
+    size_t blockBytes = 0;
+    int allocated = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        const AllocationRequest *request = &requests[i];
+        if (satisfied)
+        {
+            satisfied[i] = false;
+        }
+
+        Process *proc = getProcess(manager, request->processId);
+        if (!proc || request->size == 0)
+        {
+            continue;
+        }
+
+        if (manager->trace && proc->state == PROCESS_RUNNING)
+        {
+            traceRecord(manager->trace, TRACE_ALLOCATE, request->processId, request->size, false, NULL);
+        }
+
+        MemorySegment *segment;
+        switch (manager->strategy)
+        {
+        case BUDDY:
+            segment = buddyAllocateBlock(manager, request->size);
+            break;
+        case TLSF:
+            segment = tlsfAllocateBlock(manager, request->size);
+            break;
+        default:
+            segment = findBatchSegment(manager, request->size, &firstFitStart, &firstFitSkipped);
+            if (!segment && manager->compactOnFailure && manager->freeBlockBytes >= request->size)
+            {
+                // Compaction merges the holes, so first fit starts over from the head
+                compactMemory(manager);
+                firstFitStart = manager->segmentList;
+                firstFitSkipped = 0;
+                segment = findBatchSegment(manager, request->size, &firstFitStart, &firstFitSkipped);
+            }
+            break;
+        }
+
+        if (!segment)
+        {
+            continue;
+        }
+
+        if (manager->strategy != BUDDY && manager->strategy != TLSF)
+        {
+            if (!carveSegment(manager, segment, request->size))
+            {
+                continue;
+            }
+            manager->nextFitCursor = segment->next;
+        }
+        setSegmentOwner(manager, segment, request->size, request->processId, segmentType);
+        usedBytes += request->size;
+        blockBytes += segment->size;
+
+        proc->segmentCount++;
+        segment->nextInProcess = proc->segments;
+        proc->segments = segment;
+
+        allocated++;
+        if (satisfied)
+        {
+            satisfied[i] = true;
+        }
+    }
+
+    // Update memory stats once for the whole batch
+    manager->usedMemory += usedBytes;
+    manager->freeMemory -= blockBytes;
+    manager->allocatedBlockBytes += blockBytes;
+    manager->wastedBlockBytes += blockBytes - usedBytes;
+
+    char logMsg[150];
+    sprintf(logMsg, "Allocated %d of %d %s segments (%zu bytes) in one batch", allocated, count, segmentType, usedBytes);
+    if (allocated == count)
+    {
+        info(logMsg);
+    }
+    else
+    {
+        warn(logMsg);
+    }
+
+    return allocated;
+}
+
+// Merge a newly freed segment with its free neighbours and index the survivor
+static MemorySegment *coalesceFreeSegment(MemoryManager *manager, MemorySegment *segment)
+{
+    MemorySegment *prev = segment->prev;
+    if (prev && !prev->allocated)
+    {
+        // Fold the segment into its free predecessor
+        unindexFreeSegment(manager, prev);
+        prev->size += segment->size;
+        unlinkNextSegment(prev);
+        if (manager->nextFitCursor == segment)
+        {
+            manager->nextFitCursor = prev;
+        }
+        releaseSegmentNode(manager, segment);
+        segment = prev;
+    }
+
+    MemorySegment *next = segment->next;
+    if (next && !next->allocated)
+    {
+        // Absorb the free successor
+        unindexFreeSegment(manager, next);
+        segment->size += next->size;
+        unlinkNextSegment(segment);
+        if (manager->nextFitCursor == next)
+        {
+            manager->nextFitCursor = segment;
+        }
+        releaseSegmentNode(manager, next);
+    }
+
+    indexFreeSegment(manager, segment);
+    return segment;
+}
+
+// Free all segments allocated to a process
+void deallocateSegments(MemoryManager *manager, int processId)
+{
+    Process *proc = getProcess(manager, processId);
+    if (!proc)
+    {
+        return;
+    }
+    size_t freedMemory = 0;
+
+    // Walk only the segments this process owns; each one coalesces with its free neighbours in O(1)
+    MemorySegment *segment = proc->segments;
+    while (segment)
+    {
+        MemorySegment *nextOwned = segment->nextInProcess;
+
+        manager->usedMemory -= segment->usedBytes;
+        manager->freeMemory += segment->size;
+        freedMemory += segment->size;
+        releaseSegmentOwnership(manager, segment);
+
+        switch (manager->strategy)
+        {
+        case BUDDY:
+            buddyReleaseBlock(manager, segment);
+            break;
+        case TLSF:
+            tlsfReleaseBlock(manager, segment);
+            break;
+        default:
+            coalesceFreeSegment(manager, segment);
+            break;
+        }
+
+        segment = nextOwned;
+    }
+    proc->segments = NULL;
+    proc->segmentCount = 0;
+
+    char logMsg[100];
+    sprintf(logMsg, "Deallocated all segments for process %s (ID: %d), freed %zu bytes",
+            proc->name, processId, freedMemory);
+    info(logMsg);
+}
+
+// Slide the allocated segment after a hole down into it; the hole moves up and merges with any free successor
+static MemorySegment *slideSegmentIntoHole(MemoryManager *manager, MemorySegment *hole)
+{
+    MemorySegment *segment = hole->next;
+    MemorySegment *before = hole->prev;
+    MemorySegment *after = segment->next;
+
+    unindexFreeSegment(manager, hole);
+
+    // Swap the two nodes in address order; the segment node keeps its process ownership link
+    if (before)
+    {
+        before->next = segment;
+    }
+    else
+    {
+        manager->segmentList = segment;
+    }
+    segment->prev = before;
+    segment->next = hole;
+    hole->prev = segment;
+    hole->next = after;
+    if (after)
+    {
+        after->prev = hole;
+    }
+
+    segment->address = hole->address;
+    hole->address = segment->address + segment->size;
+
+    return coalesceFreeSegment(manager, hole);
+}
+
+// Sweep from the compaction cursor, moving at most maxBytes and visiting at most maxSegments segments
+static CompactionResult runCompaction(MemoryManager *manager, size_t maxBytes, int maxSegments)
+{
+    CompactionResult result = {0, 0, 0.0, false};
+    clock_t start = clock();
+
+    MemorySegment *current = manager->compactCursor ? manager->compactCursor : manager->segmentList;
+    int visited = 0;
+
+    while (current && visited < maxSegments)
+    {
+        visited++;
+
+        // Free neighbours are always coalesced, so a hole is followed by an allocated segment or nothing
+        if (!current->allocated && current->next)
+        {
+            size_t moveBytes = current->next->size;
+            if (result.bytesMoved > 0 && result.bytesMoved + moveBytes > maxBytes)
+            {
+                break;
+            }
+
+            current = slideSegmentIntoHole(manager, current);
+            result.segmentsMoved++;
+            result.bytesMoved += moveBytes;
+        }
+        else
+        {
+            current = current->next;
+        }
+    }
+
+    result.complete = current == NULL;
+    manager->compactCursor = current;
+    result.elapsedMs = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+    return result;
+}
+
+// Compact all of memory in one stop-the-world pass
+CompactionResult compactMemory(MemoryManager *manager)
+{
+    CompactionResult result = {0, 0, 0.0, false};
+    if (manager->strategy != SEGMENTATION && manager->strategy != HYBRID)
+    {
+        warn("Compaction is only supported for the segmentation and hybrid strategies");
+        return result;
+    }
+
+    manager->compactCursor = NULL;
+    result = runCompaction(manager, SIZE_MAX, INT_MAX);
+
+    char logMsg[150];
+    sprintf(logMsg, "Full compaction: moved %d segments (%zu bytes) in %.3f ms",
+            result.segmentsMoved, result.bytesMoved, result.elapsedMs);
+    info(logMsg);
+
+    return result;
+}
+
+// Do a bounded slice of compaction, resuming where the previous step stopped
+CompactionResult compactMemoryStep(MemoryManager *manager, size_t maxBytes)
+{
+    CompactionResult result = {0, 0, 0.0, false};
+    if (manager->strategy != SEGMENTATION && manager->strategy != HYBRID)
+    {
+        warn("Compaction is only supported for the segmentation and hybrid strategies");
+        return result;
+    }
+
+    result = runCompaction(manager, maxBytes, COMPACTION_STEP_MAX_SEGMENTS);
+
+    char logMsg[150];
+    sprintf(logMsg, "Incremental compaction: moved %d segments (%zu bytes) in %.3f ms%s",
+            result.segmentsMoved, result.bytesMoved, result.elapsedMs, result.complete ? ", sweep complete" : "");
+    info(logMsg);
+
+    return result;
+}
+
+// Allocate an empty radix node (levels above the leaves)
+static PageTableNode *createPageTableNode(PageTable *pageTable)
+{
+    PageTableNode *node = (PageTableNode *)calloc(1, sizeof(PageTableNode));
+    if (!node)
+    {
+        error("Failed to allocate memory for page table node");
+        return NULL;
+    }
+    pageTable->nodeCount++;
+    return node;
+}
+
+// Allocate a leaf table with every entry unmapped
+static Page *createPageTableLeaf(PageTable *pageTable)
+{
+    Page *leaf = (Page *)calloc(PAGE_TABLE_FANOUT, sizeof(Page));
+    if (!leaf)
+    {
+        error("Failed to allocate memory for page table leaf");
+        return NULL;
+    }
+    for (int i = 0; i < PAGE_TABLE_FANOUT; i++)
+    {
+        leaf[i].processId = -1;
+        leaf[i].residency = RESIDENCY_NONE;
+        leaf[i].swapSlot = SWAP_NO_SLOT;
+    }
+    pageTable->leafCount++;
+    return leaf;
+}
+
+// Walk the radix tree to the entry slot for vpage, allocating missing levels when create is set
+static Page *pageTableWalk(PageTable *pageTable, size_t vpage, bool create)
+{
+    if (vpage >= PAGE_TABLE_MAX_VPAGES)
+    {
+        return NULL;
+    }
+
+    if (!pageTable->root)
+    {
+        if (!create || !(pageTable->root = createPageTableNode(pageTable)))
+        {
+            return NULL;
+        }
+    }
+
+    // Descend the interior levels; level 1 is the leaf table
+    PageTableNode *node = pageTable->root;
+    for (int level = PAGE_TABLE_LEVELS; level > 1; level--)
+    {
+        size_t index = (vpage >> ((level - 1) * PAGE_TABLE_BITS)) & (PAGE_TABLE_FANOUT - 1);
+        if (!node->children[index])
+        {
+            if (!create)
+            {
+                return NULL;
+            }
+            node->children[index] = level > 2 ? (void *)createPageTableNode(pageTable) : (void *)createPageTableLeaf(pageTable);
+            if (!node->children[index])
+            {
+                return NULL;
+            }
+        }
+
+        if (level == 2)
+        {
+            Page *leaf = (Page *)node->children[index];
+            return &leaf[vpage & (PAGE_TABLE_FANOUT - 1)];
+        }
+        node = (PageTableNode *)node->children[index];
+    }
+
+    return NULL;
+}
+
+// Find the entry for a mapped virtual page, or NULL if it is not mapped
+Page *pageTableLookup(PageTable *pageTable, size_t vpage)
+{
+    Page *entry = pageTable ? pageTableWalk(pageTable, vpage, false) : NULL;
+    return entry && entry->processId >= 0 ? entry : NULL;
+}
+
+// Bytes used by the page table structures themselves
+size_t pageTableMemory(const PageTable *pageTable)
+{
+    if (!pageTable)
+        return 0;
+
+    return sizeof(PageTable) + pageTable->nodeCount * sizeof(PageTableNode) +
+           pageTable->leafCount * PAGE_TABLE_FANOUT * sizeof(Page);
+}
+
+// Free a subtree of a page table; with a manager, the frames of resident entries are released first
+static void releasePageTableNode(MemoryManager *manager, void *node, int level, size_t *freedPages, size_t *freedMemory)
+{
+    if (!node)
+    {
+        return;
+    }
+
+    if (level > 1)
+    {
+        PageTableNode *interior = (PageTableNode *)node;
+        for (int i = 0; i < PAGE_TABLE_FANOUT; i++)
+        {
+            releasePageTableNode(manager, interior->children[i], level - 1, freedPages, freedMemory);
+        }
+        free(interior);
+        return;
+    }
+
+    Page *leaf = (Page *)node;
+    for (int i = 0; manager && i < PAGE_TABLE_FANOUT; i++)
+    {
+        Page *entry = &leaf[i];
+        if (entry->processId < 0)
+        {
+            continue;
+        }
+
+        // Drop the entry from the replacement lists, ARC ghosts included, and its copy on swap
+        residencyRemove(manager, entry);
+        if (manager->swap && entry->swapSlot != SWAP_NO_SLOT)
+        {
+            swapReleaseSlot(manager->swap, entry);
+        }
+        if (!entry->allocated)
+        {
+            continue; // Never faulted in, or evicted
+        }
+
+        Page *frame = &manager->pageFrames[entry->frameNumber];
+        if (frame->refCount > 1)
+        {
+            // Still mapped by a forked relative: drop this reference only
+            frame->refCount--;
+            manager->cowStats.sharedPages--;
+            if (frame->processId == entry->processId)
+            {
+                frame->processId = SHARED_PROCESS_ID;
+            }
+            continue;
+        }
+
+        (*freedPages)++;
+        *freedMemory += frame->usedBytes;
+        if (frame->huge)
+        {
+            // The first frame of a huge page stands for the whole page in the count
+            manager->hugeFrameUsedBytes -= frame->usedBytes;
+            if (entry->frameNumber % (manager->hugePageSize / manager->pageSize) == 0)
+            {
+                manager->hugePagesAllocated--;
+            }
+            frame->huge = false;
+        }
+        setFrameAllocated(manager, entry->frameNumber, false);
+        frame->processId = -1;
+        frame->usedBytes = 0;
+        frame->refCount = 0;
+    }
+    free(leaf);
+}
+
+// Point a page table entry for virtual page vpage at a physical frame
+static void mapPageTableEntry(Page *entry, size_t vpage, const Page *frame)
+{
+    memcpy(entry, frame, sizeof(Page));
+    entry->id = vpage; // Virtual page number; frameNumber holds the physical frame
+    entry->slab = NULL;
+    entry->refCount = 0;
+    entry->readOnly = false;
+    entry->dirty = false;
+    entry->referenced = false;
+    entry->residency = RESIDENCY_NONE;
+    entry->listPrev = NULL;
+    entry->listNext = NULL;
+    entry->swapSlot = SWAP_NO_SLOT;
+    entry->prefetched = false;
+}
+
+// Set up a page table entry for a virtual page that is not yet backed by a frame
+static void reservePageTableEntry(Page *entry, size_t vpage, int processId, size_t usedBytes)
+{
+    entry->id = vpage;
+    entry->frameNumber = 0;
+    entry->allocated = false;
+    entry->processId = processId;
+    entry->usedBytes = usedBytes;
+    entry->slab = NULL;
+    entry->huge = false;
+    entry->refCount = 0;
+    entry->readOnly = false;
+    entry->dirty = false;
+    entry->referenced = false;
+    entry->residency = RESIDENCY_NONE;
+    entry->listPrev = NULL;
+    entry->listNext = NULL;
+    entry->swapSlot = SWAP_NO_SLOT;
+    entry->prefetched = false;
+}
+
+// Bytes of page i in use when numPages pages hold size bytes (only the last page may be partial)
+static size_t pageBytesUsed(MemoryManager *manager, size_t size, size_t i, size_t numPages)
+{
+    return (i == numPages - 1) ? (size % manager->pageSize == 0 ? manager->pageSize : size % manager->pageSize) : manager->pageSize;
+}
+
+// Give a free frame to a process and record the mapping in its page table
+static void mapFrame(MemoryManager *manager, PageTable *pageTable, size_t vpage, size_t frameIndex, int processId,
+                     size_t usedBytes, bool huge)
+{
+    Page *frame = &manager->pageFrames[frameIndex];
+    setFrameAllocated(manager, frameIndex, true);
+    frame->processId = processId;
+    frame->usedBytes = usedBytes;
+    frame->huge = huge;
+    frame->refCount = 1;
+
+    mapPageTableEntry(pageTableWalk(pageTable, vpage, false), vpage, frame);
+}
+
+// Where allocatePagesAt's frame searches start. A zeroed cursor searches from frame 0; a batch keeps one across its
+// requests, which is exact because frames are only taken, never released, while the batch is placed
+typedef struct
+{
+    size_t runStart;   // Contiguous search: start of a free run, with no run before it longer than runLongest
+    size_t runLongest;
+    size_t hugeStart;  // No aligned huge-page run is free before this frame
+    size_t firstFree;  // Every frame before this one is allocated
+} FrameCursor;
+
+// First contiguous run of numPages free frames, or -1; resumes at the cursor when no run passed over is long enough
+static long findCursorRun(MemoryManager *manager, FrameCursor *cursor, size_t numPages)
+{
+    size_t longest = 0;
+    if (numPages > cursor->runLongest)
+    {
+        long start = findFreeRun(manager, cursor->runStart, numPages, 1, &longest);
+        if (start >= 0)
+        {
+            cursor->runStart = start;
+            cursor->runLongest = longest > cursor->runLongest ? longest : cursor->runLongest;
+        }
+        return start;
+    }
+
+    long start = findFreeRun(manager, 0, numPages, 1, &longest);
+    if (start >= (long)cursor->runStart)
+    {
+        cursor->runStart = start;
+    }
+    return start;
+}
+
+// Allocate pages for a process, mapped past the highest page it already has
+bool allocatePages(MemoryManager *manager, int processId, size_t size)
+{
+    Process *proc = getProcess(manager, processId);
+    size_t firstPage = proc && proc->pageTable ? proc->pageTable->topPage : 0;
+    return allocatePagesAt(manager, processId, firstPage * manager->pageSize, size);
+}
+
+// Create the page table entries for numPages virtual pages from firstPage, all of which must be unmapped
+static bool preparePageRange(Process *proc, int processId, size_t firstPage, size_t numPages)
+{
+    // Allocate page table for the process
+    if (!proc->pageTable)
+    {
+        proc->pageTable = (PageTable *)malloc(sizeof(PageTable));
+        proc->pageTable->processId = processId;
+        proc->pageTable->root = NULL;
+        proc->pageTable->pageCount = 0;
+        proc->pageTable->topPage = 0;
+        proc->pageTable->nodeCount = 0;
+        proc->pageTable->leafCount = 0;
+    }
+
+    // Build the radix path for every page up front so a failure leaves nothing half-mapped
+    for (size_t i = 0; i < numPages; i++)
+    {
+        Page *entry = pageTableWalk(proc->pageTable, firstPage + i, true);
+        if (!entry || entry->processId >= 0)
+        {
+            char errMsg[150];
+            sprintf(errMsg, "Cannot map virtual page %zu for process %s: %s", firstPage + i, proc->name,
+                    entry ? "already mapped" : "page table allocation failed");
+            error(errMsg);
+            return false;
+        }
+    }
+    proc->pageTable->pageCount += numPages;
+    if (firstPage + numPages > proc->pageTable->topPage)
+    {
+        proc->pageTable->topPage = firstPage + numPages;
+    }
+    return true;
+}
+
+// Reserve virtual pages only; accessPage faults them into frames
+static void reservePageRange(MemoryManager *manager, Process *proc, int processId, size_t firstPage, size_t numPages,
+                             size_t size)
+{
+    for (size_t i = 0; i < numPages; i++)
+    {
+        reservePageTableEntry(pageTableWalk(proc->pageTable, firstPage + i, false), firstPage + i, processId,
+                              pageBytesUsed(manager, size, i, numPages));
+    }
+}
+
+// Back a prepared range of virtual pages with frames; returns the number of huge pages used and adds the bytes they
+// hold to hugeBytes. The caller updates the memory stats
+static size_t backPageRange(MemoryManager *manager, Process *proc, int processId, size_t firstPage, size_t numPages,
+                            size_t size, FrameCursor *cursor, size_t *hugeBytes)
+{
+    // Back fully covered, aligned huge-page ranges first so base pages cannot split the aligned runs
+    size_t hugeFrames = manager->hugePageSize / manager->pageSize;
+    size_t hugeMapped = 0;
+    for (size_t i = hugeFrames > 1 ? (hugeFrames - firstPage % hugeFrames) % hugeFrames : numPages;
+         i + hugeFrames <= numPages; i += hugeFrames)
+    {
+        long hugeStart = findFreeRun(manager, cursor->hugeStart, hugeFrames, hugeFrames, NULL);
+        if (hugeStart < 0)
+        {
+            cursor->hugeStart = manager->totalPages;
+            break; // No aligned run left; the rest of the range falls back to base pages
+        }
+        cursor->hugeStart = hugeStart;
+
+        for (size_t j = 0; j < hugeFrames; j++)
+        {
+            size_t usedInPage = pageBytesUsed(manager, size, i + j, numPages);
+            mapFrame(manager, proc->pageTable, firstPage + i + j, hugeStart + j, processId, usedInPage, true);
+            *hugeBytes += usedInPage;
+        }
+        hugeMapped++;
+    }
+
+    // Assign the remaining pages using either contiguous or scattered allocation based on availability
+    size_t remaining = numPages - hugeMapped * hugeFrames;
+    long startFrame = remaining > 0 ? findCursorRun(manager, cursor, remaining) : -1;
+    long frameIndex = startFrame >= 0 ? startFrame : findFreeFrame(manager, cursor->firstFree);
+
+    for (size_t i = 0; i < numPages; i++)
+    {
+        if (pageTableLookup(proc->pageTable, firstPage + i))
+        {
+            continue; // Already backed by a huge page
+        }
+
+        mapFrame(manager, proc->pageTable, firstPage + i, frameIndex, processId, pageBytesUsed(manager, size, i, numPages), false);
+
+        // Contiguous runs take the next frame; scattered allocation jumps to the next free one via the bitmap
+        frameIndex = startFrame >= 0 ? frameIndex + 1 : findFreeFrame(manager, frameIndex + 1);
+    }
+
+    // Scattered allocation took the lowest free frames, so the next free one is now the first
+    if (startFrame < 0)
+    {
+        cursor->firstFree = frameIndex >= 0 ? (size_t)frameIndex : manager->totalPages;
+    }
+
+    return hugeMapped;
+}
+
+// Map size bytes of a process's virtual address space starting at a page-aligned virtual address
+bool allocatePagesAt(MemoryManager *manager, int processId, size_t virtualAddress, size_t size)
+{
+    Process *proc = getProcess(manager, processId);
+    if (!proc)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Invalid process ID when allocating: %d", processId);
+        error(errMsg);
+        return false;
+    }
+
+    // Bounded as (size - 1) / pageSize so sizes near SIZE_MAX cannot wrap to zero pages
+    size_t firstPage = virtualAddress / manager->pageSize;
+    if (size == 0 || virtualAddress % manager->pageSize != 0 || firstPage >= PAGE_TABLE_MAX_VPAGES ||
+        (size - 1) / manager->pageSize >= PAGE_TABLE_MAX_VPAGES - firstPage)
+    {
+        char errMsg[150];
+        sprintf(errMsg, "Invalid page mapping: %zu bytes at virtual address %zu", size, virtualAddress);
+        error(errMsg);
+        return false;
+    }
+
+    // Only growth of a live process is an event of its own; createProcess records its initial allocation
+    if (manager->trace && proc->state == PROCESS_RUNNING)
+    {
+        traceRecordAllocateAt(manager->trace, processId, size, virtualAddress);
+    }
+
+    // Calculate how many pages are needed
+    size_t numPages = (size - 1) / manager->pageSize + 1;
+
+    if (!manager->demandPaging && numPages > manager->freePages)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Not enough free pages. Required: %zu, Available: %zu", numPages, manager->freePages);
+        error(errMsg);
+        return false;
+    }
+
+    if (!preparePageRange(proc, processId, firstPage, numPages))
+    {
+        return false;
+    }
+
+    if (manager->demandPaging)
+    {
+        reservePageRange(manager, proc, processId, firstPage, numPages, size);
+
+        char logMsg[100];
+        sprintf(logMsg, "Reserved %zu virtual pages (%zu bytes) for process %s (ID: %d)",
+                numPages, numPages * manager->pageSize, proc->name, processId);
+        info(logMsg);
+
+        return true;
+    }
+
+    FrameCursor cursor = {0, 0, 0, 0};
+    size_t hugeBytes = 0;
+    size_t hugeMapped = backPageRange(manager, proc, processId, firstPage, numPages, size, &cursor, &hugeBytes);
+
+    // Update memory stats
+    manager->freePages -= numPages;
+    manager->usedMemory += size;
+    manager->frameUsedBytes += size;
+    manager->freeMemory -= numPages * manager->pageSize;
+    manager->hugePagesAllocated += hugeMapped;
+    manager->hugeFrameUsedBytes += hugeBytes;
+
+    char logMsg[150];
+    sprintf(logMsg, "Allocated %zu pages (%zu bytes, %zu huge pages) for process %s (ID: %d)",
+            numPages, numPages * manager->pageSize, hugeMapped, proc->name, processId);
+    info(logMsg);
+
+    return true;
+}
+
+// Map pages for a batch of requests, each growing its process past the highest page it has mapped
+int allocatePagesBatch(MemoryManager *manager, const AllocationRequest *requests, int count, bool *satisfied)
+{
+    if (manager->strategy != PAGING && manager->strategy != HYBRID)
+    {
+        error("Batch page allocation is only supported for the paging and hybrid strategies");
+        return 0;
+    }
+
+    FrameCursor cursor = {0, 0, 0, 0};
+    size_t pagesMapped = 0;
+    size_t bytesMapped = 0;
+    size_t hugeMapped = 0;
+    size_t hugeBytes = 0;
+    int allocated = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        const AllocationRequest *request = &requests[i];
+        if (satisfied)
+        {
+            satisfied[i] = false;
+        }
+
+        Process *proc = getProcess(manager, request->processId);
+        if (!proc || request->size == 0)
+        {
+            continue;
+        }
+
+        size_t firstPage = proc->pageTable ? proc->pageTable->topPage : 0;
+        if ((request->size - 1) / manager->pageSize >= PAGE_TABLE_MAX_VPAGES - firstPage)
+        {
+            continue;
+        }
+        size_t numPages = (request->size - 1) / manager->pageSize + 1;
+
+        if (manager->trace && proc->state == PROCESS_RUNNING)
+        {
+            traceRecordAllocateAt(manager->trace, request->processId, request->size, firstPage * manager->pageSize);
+        }
+
+        if (!manager->demandPaging && numPages > manager->freePages - pagesMapped)
+        {
+            continue;
+        }
+
+        if (!preparePageRange(proc, request->processId, firstPage, numPages))
+        {
+            continue;
+        }
+
+        if (manager->demandPaging)
+        {
+            reservePageRange(manager, proc, request->processId, firstPage, numPages, request->size);
+        }
+        else
+        {
+            hugeMapped += backPageRange(manager, proc, request->processId, firstPage, numPages, request->size, &cursor,
+                                        &hugeBytes);
+        }
+        pagesMapped += numPages;
+        bytesMapped += request->size;
+
+        allocated++;
+        if (satisfied)
+        {
+            satisfied[i] = true;
+        }
+    }
+
+    // Update memory stats once for the whole batch; reserved pages take no frames until they fault in
+    char logMsg[150];
+    if (manager->demandPaging)
+    {
+        sprintf(logMsg, "Reserved %zu virtual pages (%zu bytes) for %d of %d requests in one batch",
+                pagesMapped, bytesMapped, allocated, count);
+    }
+    else
+    {
+        manager->freePages -= pagesMapped;
+        manager->usedMemory += bytesMapped;
+        manager->frameUsedBytes += bytesMapped;
+        manager->freeMemory -= pagesMapped * manager->pageSize;
+        manager->hugePagesAllocated += hugeMapped;
+        manager->hugeFrameUsedBytes += hugeBytes;
+
+        sprintf(logMsg, "Allocated %zu pages (%zu bytes, %zu huge pages) for %d of %d requests in one batch",
+                pagesMapped, bytesMapped, hugeMapped, allocated, count);
+    }
+
+    if (allocated == count)
+    {
+        info(logMsg);
+    }
+    else
+    {
+        warn(logMsg);
+    }
+
+    return allocated;
+}
+
+// Let allocatePages back aligned, fully covered ranges with huge pages of hugePageSize bytes
+bool enableHugePages(MemoryManager *manager, size_t hugePageSize)
+{
+    if ((manager->strategy != PAGING && manager->strategy != HYBRID) || manager->demandPaging)
+    {
+        error("Huge pages require the paging or hybrid strategy without demand paging");
+        return false;
+    }
+
+    size_t hugeFrames = hugePageSize / manager->pageSize;
+    if (hugePageSize % manager->pageSize != 0 || hugeFrames < 2 || (hugeFrames & (hugeFrames - 1)) != 0 ||
+        hugeFrames > manager->totalPages || manager->hugePageSize != 0)
+    {
+        char errMsg[150];
+        sprintf(errMsg, "Cannot enable %zu-byte huge pages: must be a power-of-two multiple of the page size that fits in memory",
+                hugePageSize);
+        error(errMsg);
+        return false;
+    }
+
+    manager->hugePageSize = hugePageSize;
+
+    char logMsg[100];
+    sprintf(logMsg, "Huge pages enabled: %zu bytes (%zu frames)", hugePageSize, hugeFrames);
+    info(logMsg);
+
+    return true;
+}
+
+// Free all pages allocated to a process
+void deallocatePages(MemoryManager *manager, int processId)
+{
+    Process *proc = getProcess(manager, processId);
+    if (!proc)
+    {
+        return;
+    }
+
+    if (!proc->pageTable)
+    {
+        return; // No pages allocated
+    }
+
+    size_t freedPages = 0;
+    size_t freedMemory = 0;
+
+    // Shoot down the process's cached translations before its frames are reused
+    if (manager->tlb)
+    {
+        tlbInvalidateAsid(manager->tlb, processId);
+    }
+
+    // Free only the frames recorded in this process's page table, then the table itself
+    releasePageTableNode(manager, proc->pageTable->root, PAGE_TABLE_LEVELS, &freedPages, &freedMemory);
+    free(proc->pageTable);
+    proc->pageTable = NULL;
+
+    // Update memory stats
+    manager->freePages += freedPages;
+    manager->usedMemory -= freedMemory;
+    manager->frameUsedBytes -= freedMemory;
+    manager->freeMemory += freedPages * manager->pageSize;
+
+    char logMsg[100];
+    sprintf(logMsg, "Deallocated %zu pages for process %s (ID: %d), freed %zu bytes",
+            freedPages, proc->name, processId, freedMemory);
+    info(logMsg);
+}
+
+// Copy a page table subtree into childTable, sharing the frames of resident entries read-only; false when a
+// node cannot be allocated (everything copied so far is consistent, so the child table can simply be released)
+static bool sharePageTableNode(MemoryManager *manager, void *node, void **copy, int level, PageTable *childTable)
+{
+    if (level > 1)
+    {
+        PageTableNode *interior = (PageTableNode *)node;
+        PageTableNode *childNode = createPageTableNode(childTable);
+        *copy = childNode;
+        if (!childNode)
+        {
+            return false;
+        }
+
+        for (int i = 0; i < PAGE_TABLE_FANOUT; i++)
+        {
+            if (interior->children[i] &&
+                !sharePageTableNode(manager, interior->children[i], &childNode->children[i], level - 1, childTable))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Page *leaf = (Page *)node;
+    Page *childLeaf = createPageTableLeaf(childTable);
+    *copy = childLeaf;
+    if (!childLeaf)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < PAGE_TABLE_FANOUT; i++)
+    {
+        Page *entry = &leaf[i];
+        if (entry->processId < 0)
+        {
+            continue;
+        }
+
+        childLeaf[i] = *entry;
+        childLeaf[i].processId = childTable->processId;
+        if (entry->allocated)
+        {
+            // Neither side may write the frame in place any more
+            entry->readOnly = true;
+            childLeaf[i].readOnly = true;
+            manager->pageFrames[entry->frameNumber].refCount++;
+            manager->cowStats.sharedPages++;
+        }
+    }
+    return true;
+}
+
+// Create a child process whose page table maps the parent's frames instead of copies of them
+int forkProcess(MemoryManager *manager, int processId)
+{
+    Process *parent = getProcess(manager, processId);
+    if (!parent)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Invalid process ID when forking: %d", processId);
+        error(errMsg);
+        return -1;
+    }
+
+    // Shared frames are never evicted and segments have no page table to share
+    if ((manager->strategy != PAGING && manager->strategy != HYBRID) || manager->demandPaging || parent->segments)
+    {
+        error("Fork requires a paged process under the paging or hybrid strategy without demand paging");
+        return -1;
+    }
+
+    if (manager->processCount >= manager->maxProcesses)
+    {
+        error("Cannot fork: maximum process limit reached");
+        return -1;
+    }
+
+    int slot = acquireProcessSlot(manager);
+    if (slot < 0)
+    {
+        return -1;
+    }
+
+    // Growing the table may have moved the parent
+    parent = &manager->processes[PROCESS_SLOT(processId)];
+    Process *child = &manager->processes[slot];
+    int childId = (int)(child->generation << PROCESS_SLOT_BITS) | slot;
+
+    child->id = childId;
+    child->state = PROCESS_STARTING;
+    memcpy(child->name, parent->name, sizeof(child->name));
+    child->size = parent->size;
+    child->allocStrategy = parent->allocStrategy;
+    child->segments = NULL;
+    child->segmentCount = 0;
+    child->pageTable = NULL;
+
+    size_t sharedBefore = manager->cowStats.sharedPages;
+    if (parent->pageTable)
+    {
+        bool copied = false;
+        child->pageTable = (PageTable *)malloc(sizeof(PageTable));
+        if (child->pageTable)
+        {
+            child->pageTable->processId = childId;
+            child->pageTable->root = NULL;
+            child->pageTable->pageCount = parent->pageTable->pageCount;
+            child->pageTable->topPage = parent->pageTable->topPage;
+            child->pageTable->nodeCount = 0;
+            child->pageTable->leafCount = 0;
+            copied = !parent->pageTable->root ||
+                     sharePageTableNode(manager, parent->pageTable->root, (void **)&child->pageTable->root,
+                                        PAGE_TABLE_LEVELS, child->pageTable);
+        }
+
+        if (!copied)
+        {
+            error("Failed to allocate page table for forked process");
+            deallocatePages(manager, childId);
+            releaseProcessSlot(manager, slot, false);
+            return -1;
+        }
+    }
+
+    child->state = PROCESS_RUNNING;
+    manager->processCount++;
+    manager->cowStats.forks++;
+
+    // Only a fork that went through is replayable
+    if (manager->trace)
+    {
+        traceRecord(manager->trace, TRACE_FORK, childId, (size_t)processId, false, NULL);
+    }
+    if (manager->cowStats.sharedPages > manager->cowStats.peakSharedPages)
+    {
+        manager->cowStats.peakSharedPages = manager->cowStats.sharedPages;
+    }
+
+    char logMsg[150];
+    sprintf(logMsg, "Forked process %s (ID: %d) from ID %d: %zu pages shared copy-on-write",
+            child->name, childId, processId, manager->cowStats.sharedPages - sharedBefore);
+    info(logMsg);
+
+    return childId;
+}
+
+// Handle a write to a read-only page: give the writer its own copy of the shared frame (of every frame, for a
+// huge page), or just restore write access when no other entry maps the frame any more
+static bool copyOnWrite(MemoryManager *manager, PageTable *pageTable, Page *entry)
+{
+    Page *frame = &manager->pageFrames[entry->frameNumber];
+    if (frame->refCount == 1)
+    {
+        entry->readOnly = false;
+        frame->processId = entry->processId;
+        manager->cowStats.cowReuses++;
+        return true;
+    }
+
+    size_t frames = entry->huge ? manager->hugePageSize / manager->pageSize : 1;
+    long target = entry->huge ? findFreePagesAligned(manager, frames, frames) : findFreeFrame(manager, 0);
+    if (target < 0)
+    {
+        manager->cowStats.failedCopies++;
+        char errMsg[100];
+        sprintf(errMsg, "Copy-on-write fault on page %zu of process %d: no free frame", entry->id, entry->processId);
+        error(errMsg);
+        return false;
+    }
+
+    size_t firstPage = entry->id - entry->id % frames;
+    for (size_t j = 0; j < frames; j++)
+    {
+        Page *shared = frames == 1 ? entry : pageTableLookup(pageTable, firstPage + j);
+        Page *oldFrame = &manager->pageFrames[shared->frameNumber];
+        Page *newFrame = &manager->pageFrames[target + j];
+
+        oldFrame->refCount--;
+        manager->cowStats.sharedPages--;
+        if (oldFrame->processId == shared->processId)
+        {
+            oldFrame->processId = SHARED_PROCESS_ID;
+        }
+
+        setFrameAllocated(manager, target + j, true);
+        newFrame->processId = shared->processId;
+        newFrame->usedBytes = oldFrame->usedBytes;
+        newFrame->huge = entry->huge;
+        newFrame->refCount = 1;
+        manager->usedMemory += newFrame->usedBytes;
+        manager->frameUsedBytes += newFrame->usedBytes;
+        if (entry->huge)
+        {
+            manager->hugeFrameUsedBytes += newFrame->usedBytes;
+        }
+
+        if (manager->tlb)
+        {
+            tlbInvalidatePage(manager->tlb, shared->processId, shared->id);
+        }
+        shared->frameNumber = target + j;
+        shared->readOnly = false;
+    }
+
+    if (entry->huge)
+    {
+        manager->hugePagesAllocated++;
+    }
+    manager->freePages -= frames;
+    manager->freeMemory -= frames * manager->pageSize;
+    manager->cowStats.cowFaults++;
+    manager->cowStats.pagesCopied += frames;
+    return true;
+}
+
+// Append a page table entry at the most recently used end of a residency list
+static void residencyPush(MemoryManager *manager, Page *entry, ResidencyList list)
+{
+    entry->residency = list;
+    entry->listNext = NULL;
+    entry->listPrev = manager->residencyTail[list];
+    if (entry->listPrev)
+    {
+        entry->listPrev->listNext = entry;
+    }
+    else
+    {
+        manager->residencyHead[list] = entry;
+    }
+    manager->residencyTail[list] = entry;
+    manager->residencySize[list]++;
+}
+
+// Take a page table entry off whichever residency list it is on
+static void residencyRemove(MemoryManager *manager, Page *entry)
+{
+    ResidencyList list = entry->residency;
+    if (list == RESIDENCY_NONE)
+    {
+        return;
+    }
+
+    if (entry->listPrev)
+    {
+        entry->listPrev->listNext = entry->listNext;
+    }
+    else
+    {
+        manager->residencyHead[list] = entry->listNext;
+    }
+
+    if (entry->listNext)
+    {
+        entry->listNext->listPrev = entry->listPrev;
+    }
+    else
+    {
+        manager->residencyTail[list] = entry->listPrev;
+    }
+
+    entry->listPrev = NULL;
+    entry->listNext = NULL;
+    entry->residency = RESIDENCY_NONE;
+    manager->residencySize[list]--;
+}
+
+// Give a resident page's frame back and park the entry on ghostList (RESIDENCY_NONE forgets it)
+static void evictPage(MemoryManager *manager, Page *entry, ResidencyList ghostList)
+{
+    if (manager->tlb)
+    {
+        tlbInvalidatePage(manager->tlb, entry->processId, entry->id);
+    }
+
+    Page *frame = &manager->pageFrames[entry->frameNumber];
+    setFrameAllocated(manager, entry->frameNumber, false);
+    manager->frameUsedBytes -= frame->usedBytes;
+    manager->usedMemory -= frame->usedBytes;
+    frame->processId = -1;
+    frame->usedBytes = 0;
+    frame->refCount = 0;
+
+    manager->freePages++;
+    manager->freeMemory += manager->pageSize;
+
+    manager->pagingStats.evictions++;
+    if (entry->dirty)
+    {
+        manager->pagingStats.dirtyEvictions++;
+    }
+
+    // Written contents go to swap; a clean page keeps whatever copy swap already holds
+    if (manager->swap && entry->dirty)
+    {
+        swapQueueWriteback(manager->swap, entry);
+    }
+    entry->prefetched = false;
+
+    entry->allocated = false;
+    entry->dirty = false;
+    entry->referenced = false;
+    residencyRemove(manager, entry);
+    if (ghostList != RESIDENCY_NONE)
+    {
+        residencyPush(manager, entry, ghostList);
+    }
+}
+
+// Evict the FIFO/LRU/Clock victim: the head of T1, after Clock's second chances
+static bool evictVictim(MemoryManager *manager)
+{
+    Page *victim = manager->residencyHead[RESIDENCY_T1];
+
+    if (manager->replacement == REPLACEMENT_CLOCK)
+    {
+        // The list is the clock face and its head the hand; referenced pages are cleared and passed over
+        while (victim && victim->referenced)
+        {
+            victim->referenced = false;
+            residencyRemove(manager, victim);
+            residencyPush(manager, victim, RESIDENCY_T1);
+            victim = manager->residencyHead[RESIDENCY_T1];
+        }
+    }
+
+    if (!victim)
+    {
+        return false;
+    }
+
+    evictPage(manager, victim, RESIDENCY_NONE);
+    return true;
+}
+
+// ARC's REPLACE: evict from T1 while it is over its target, otherwise from T2
+static bool arcReplace(MemoryManager *manager, bool ghostHitInB2)
+{
+    size_t t1Size = manager->residencySize[RESIDENCY_T1];
+    bool preferT1 = (ghostHitInB2 && t1Size == manager->arcTarget) || t1Size > manager->arcTarget;
+
+    if (t1Size > 0 && (preferT1 || !manager->residencyHead[RESIDENCY_T2]))
+    {
+        evictPage(manager, manager->residencyHead[RESIDENCY_T1], RESIDENCY_B1);
+        return true;
+    }
+
+    if (manager->residencyHead[RESIDENCY_T2])
+    {
+        evictPage(manager, manager->residencyHead[RESIDENCY_T2], RESIDENCY_B2);
+        return true;
+    }
+
+    return false;
+}
+
+// ARC bookkeeping for a missing page; returns the list the page joins once it is faulted in
+static ResidencyList arcPrepareFault(MemoryManager *manager, Page *entry, bool *ghostHitInB2)
+{
+    size_t capacity = manager->totalPages;
+    size_t b1Size = manager->residencySize[RESIDENCY_B1];
+    size_t b2Size = manager->residencySize[RESIDENCY_B2];
+    *ghostHitInB2 = false;
+
+    if (entry->residency == RESIDENCY_B1)
+    {
+        // Recently evicted from T1: grow T1's target
+        size_t delta = b1Size >= b2Size ? 1 : b2Size / b1Size;
+        manager->arcTarget = manager->arcTarget + delta < capacity ? manager->arcTarget + delta : capacity;
+        residencyRemove(manager, entry);
+        return RESIDENCY_T2;
+    }
+
+    if (entry->residency == RESIDENCY_B2)
+    {
+        // Recently evicted from T2: shrink T1's target
+        size_t delta = b2Size >= b1Size ? 1 : b1Size / b2Size;
+        manager->arcTarget = manager->arcTarget > delta ? manager->arcTarget - delta : 0;
+        residencyRemove(manager, entry);
+        *ghostHitInB2 = true;
+        return RESIDENCY_T2;
+    }
+
+    // A brand new page: keep the L1 (T1 + B1) and total directory sizes within c and 2c
+    size_t t1Size = manager->residencySize[RESIDENCY_T1];
+    size_t l1Size = t1Size + b1Size;
+    size_t totalSize = l1Size + manager->residencySize[RESIDENCY_T2] + b2Size;
+
+    if (l1Size >= capacity)
+    {
+        if (t1Size < capacity && manager->residencyHead[RESIDENCY_B1])
+        {
+            residencyRemove(manager, manager->residencyHead[RESIDENCY_B1]);
+        }
+        else if (manager->residencyHead[RESIDENCY_T1])
+        {
+            evictPage(manager, manager->residencyHead[RESIDENCY_T1], RESIDENCY_NONE);
+        }
+    }
+    else if (totalSize >= 2 * capacity && manager->residencyHead[RESIDENCY_B2])
+    {
+        residencyRemove(manager, manager->residencyHead[RESIDENCY_B2]);
+    }
+
+    return RESIDENCY_T1;
+}
+
+// Switch a paging or hybrid manager to demand paging with the given replacement policy
+bool enableDemandPaging(MemoryManager *manager, ReplacementPolicy policy)
+{
+    if (manager->strategy != PAGING && manager->strategy != HYBRID)
+    {
+        error("Demand paging requires the paging or hybrid strategy");
+        return false;
+    }
+
+    if (manager->processSlots > 0)
+    {
+        error("Demand paging must be enabled before any process is created");
+        return false;
+    }
+
+    manager->demandPaging = true;
+    manager->replacement = policy;
+
+    char logMsg[100];
+    sprintf(logMsg, "Demand paging enabled with %s replacement", replacementPolicyName(policy));
+    info(logMsg);
+
+    return true;
+}
+
+// Back a non-resident page table entry with a free frame
+static void loadPage(MemoryManager *manager, Page *entry, long frameNumber)
+{
+    Page *frame = &manager->pageFrames[frameNumber];
+    setFrameAllocated(manager, frameNumber, true);
+    frame->processId = entry->processId;
+    frame->usedBytes = entry->usedBytes;
+    frame->refCount = 1;
+
+    manager->freePages--;
+    manager->freeMemory -= manager->pageSize;
+    manager->usedMemory += entry->usedBytes;
+    manager->frameUsedBytes += entry->usedBytes;
+
+    entry->frameNumber = frameNumber;
+    entry->allocated = true;
+}
+
+// Bring a faulting page's contents back from the writeback buffer or the swap device. A device read also
+// takes the process's following pages when they sit in the following slots (readahead), evicting older
+// pages for them if needed; ARC sizes its lists by faults alone, so it gets no readahead
+static void swapInPage(MemoryManager *manager, PageTable *pageTable, Page *entry, bool isWrite)
+{
+    SwapDevice *swap = manager->swap;
+    if (entry->swapSlot == SWAP_SLOT_PENDING)
+    {
+        swapReclaimPending(swap, entry);
+        return;
+    }
+
+    Page *run[SWAP_MAX_READAHEAD + 1];
+    size_t count = 1;
+    run[0] = entry;
+
+    // The run stays off the resident list until it has been read, so no victim is taken from it (Clock's hand
+    // could otherwise pass every older page and come round to the run); it then joins the newest end in order
+    bool readahead = manager->replacement != REPLACEMENT_ARC && swap->readahead > 0;
+    if (readahead)
+    {
+        residencyRemove(manager, entry);
+    }
+    while (readahead && count <= (size_t)swap->readahead)
+    {
+        Page *next = pageTableLookup(pageTable, entry->id + count);
+        if (!next || next->allocated || next->residency != RESIDENCY_NONE || next->swapSlot != entry->swapSlot + (long)count)
+        {
+            break;
+        }
+
+        if (manager->freePages == 0 && !evictVictim(manager))
+        {
+            break;
+        }
+
+        loadPage(manager, next, findFreeFrame(manager, 0));
+        next->dirty = false;
+        next->referenced = false;
+        next->prefetched = true;
+        run[count++] = next;
+    }
+    for (size_t i = 0; readahead && i < count; i++)
+    {
+        residencyPush(manager, run[i], RESIDENCY_T1);
+    }
+    swapReadPages(swap, run, count);
+
+    // A write makes the copy on swap stale
+    if (isWrite)
+    {
+        swapReleaseSlot(swap, entry);
+    }
+}
+
+// Resolve a virtual page to its resident page table entry and frame: TLB first, then the page table,
+// faulting the page in (and evicting a victim if needed) when it is not resident
+static Page *resolvePage(MemoryManager *manager, int processId, size_t vpage, bool isWrite, size_t *physicalFrame)
+{
+    Process *proc = getProcess(manager, processId);
+    if (!proc || !proc->pageTable)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Invalid process ID when accessing a page: %d", processId);
+        error(errMsg);
+        return NULL;
+    }
+
+    // A TLB hit skips the page table walk (a cached translation is always for a resident page, and is shot
+    // down before its entry is unmapped or evicted)
+    Page *entry = NULL;
+    size_t cachedFrame = 0;
+    bool inTlb = manager->tlb && tlbLookup(manager->tlb, processId, vpage, &cachedFrame, &entry);
+    if (!inTlb)
+    {
+        entry = pageTableLookup(proc->pageTable, vpage);
+    }
+    if (!entry)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Invalid page access: process %d has no virtual page %zu", processId, vpage);
+        error(errMsg);
+        return NULL;
+    }
+    manager->pagingStats.accesses++;
+
+    if (manager->analytics)
+    {
+        analyticsRecordAccess(manager->analytics, processId, vpage);
+    }
+
+    if (entry->allocated)
+    {
+        // A write to a shared page takes a copy-on-write fault first, which moves the entry to a new frame
+        if (isWrite && entry->readOnly)
+        {
+            size_t sharedFrame = entry->frameNumber;
+            if (!copyOnWrite(manager, proc->pageTable, entry))
+            {
+                return NULL;
+            }
+            inTlb = inTlb && entry->frameNumber == sharedFrame;
+        }
+
+        manager->pagingStats.hits++;
+        entry->dirty = entry->dirty || isWrite;
+
+        if (entry->prefetched)
+        {
+            entry->prefetched = false;
+            if (manager->swap)
+            {
+                manager->swap->stats.readaheadHits++;
+            }
+        }
+
+        // A write makes the copy on swap stale
+        if (isWrite && manager->swap && entry->swapSlot >= 0)
+        {
+            swapReleaseSlot(manager->swap, entry);
+        }
+
+        // Entries mapped up front (without demand paging) sit on no list and are never evicted
+        if (entry->residency != RESIDENCY_NONE)
+        {
+            switch (manager->replacement)
+            {
+            case REPLACEMENT_FIFO:
+                break;
+            case REPLACEMENT_LRU:
+                residencyRemove(manager, entry);
+                residencyPush(manager, entry, RESIDENCY_T1);
+                break;
+            case REPLACEMENT_CLOCK:
+                entry->referenced = true;
+                break;
+            case REPLACEMENT_ARC:
+                // A second access promotes the page to the frequency list
+                residencyRemove(manager, entry);
+                residencyPush(manager, entry, RESIDENCY_T2);
+                break;
+            }
+        }
+
+        // Translate from the TLB on a hit; a walk (or a copy-on-write move) fills it
+        if (manager->tlb && !inTlb)
+        {
+            tlbInsert(manager->tlb, processId, vpage, entry->frameNumber, entry);
+        }
+        *physicalFrame = inTlb ? cachedFrame : entry->frameNumber;
+        return entry;
+    }
+
+    manager->pagingStats.faults++;
+
+    ResidencyList target = RESIDENCY_T1;
+    bool ghostHitInB2 = false;
+    if (manager->replacement == REPLACEMENT_ARC)
+    {
+        target = arcPrepareFault(manager, entry, &ghostHitInB2);
+    }
+
+    // Make room when every frame is taken
+    if (manager->freePages == 0)
+    {
+        if (manager->replacement == REPLACEMENT_ARC)
+        {
+            arcReplace(manager, ghostHitInB2);
+        }
+        else
+        {
+            evictVictim(manager);
+        }
+    }
+
+    long frameNumber = findFreeFrame(manager, 0);
+    if (frameNumber < 0)
+    {
+        manager->pagingStats.failedFaults++;
+        char errMsg[100];
+        sprintf(errMsg, "Page fault on page %zu of process %d: no free or evictable frame", vpage, processId);
+        error(errMsg);
+        return NULL;
+    }
+
+    // Fault the page in, reading it back when it was swapped out
+    loadPage(manager, entry, frameNumber);
+    entry->dirty = isWrite;
+    entry->referenced = true;
+    residencyPush(manager, entry, target);
+
+    if (manager->swap && entry->swapSlot != SWAP_NO_SLOT)
+    {
+        swapInPage(manager, proc->pageTable, entry, isWrite);
+    }
+
+    if (manager->tlb)
+    {
+        tlbInsert(manager->tlb, processId, vpage, entry->frameNumber, entry);
+    }
+    *physicalFrame = entry->frameNumber;
+    return entry;
+}
+
+// Touch a virtual page of a process, faulting it in when demand paging is enabled
+bool accessPage(MemoryManager *manager, int processId, size_t vpage, bool isWrite)
+{
+    if (manager->trace)
+    {
+        traceRecord(manager->trace, TRACE_ACCESS, processId, vpage * manager->pageSize, isWrite, NULL);
+    }
+
+    size_t frameNumber;
+    return resolvePage(manager, processId, vpage, isWrite, &frameNumber) != NULL;
+}
+
+// Translate a process virtual address to a physical address
+bool translateAddress(MemoryManager *manager, int processId, size_t virtualAddress, bool isWrite, size_t *physicalAddress)
+{
+    if (manager->trace)
+    {
+        traceRecord(manager->trace, TRACE_ACCESS, processId, virtualAddress, isWrite, NULL);
+    }
+
+    size_t frameNumber;
+    if (!resolvePage(manager, processId, virtualAddress / manager->pageSize, isWrite, &frameNumber))
+    {
+        return false;
+    }
+
+    *physicalAddress = frameNumber * manager->pageSize + virtualAddress % manager->pageSize;
+    return true;
+}
+
+// Print demand paging counters
+void printPagingStats(MemoryManager *manager)
+{
+    if (!manager)
+        return;
+
+    PagingStats *stats = &manager->pagingStats;
+
+    char logMsg[200];
+    sprintf(logMsg, "======== Demand Paging (%s) ========", replacementPolicyName(manager->replacement));
+    info(logMsg);
+
+    sprintf(logMsg, "Accesses: %zu, Hits: %zu, Faults: %zu (%.2f%% hit rate), Failed faults: %zu",
+            stats->accesses, stats->hits, stats->faults,
+            stats->accesses > 0 ? (double)stats->hits / stats->accesses * 100 : 0.0, stats->failedFaults);
+    info(logMsg);
+
+    sprintf(logMsg, "Evictions: %zu (dirty: %zu), Resident pages: %zu of %zu frames",
+            stats->evictions, stats->dirtyEvictions,
+            manager->residencySize[RESIDENCY_T1] + manager->residencySize[RESIDENCY_T2], manager->totalPages);
+    info(logMsg);
+
+    if (manager->replacement == REPLACEMENT_ARC)
+    {
+        sprintf(logMsg, "ARC: T1: %zu, T2: %zu, B1: %zu, B2: %zu, target T1 size: %zu",
+                manager->residencySize[RESIDENCY_T1], manager->residencySize[RESIDENCY_T2],
+                manager->residencySize[RESIDENCY_B1], manager->residencySize[RESIDENCY_B2], manager->arcTarget);
+        info(logMsg);
+    }
+}
+
+// Print copy-on-write sharing between forked processes
+void printCowStats(MemoryManager *manager)
+{
+    if (!manager)
+        return;
+
+    CowStats *stats = &manager->cowStats;
+
+    char logMsg[200];
+    info("======== Copy-on-Write ========");
+
+    sprintf(logMsg, "Forks: %zu, Shared pages: %zu (peak: %zu), Memory saved: %zu bytes (peak: %zu bytes)",
+            stats->forks, stats->sharedPages, stats->peakSharedPages,
+            stats->sharedPages * manager->pageSize, stats->peakSharedPages * manager->pageSize);
+    info(logMsg);
+
+    sprintf(logMsg, "COW faults: %zu (%zu pages copied), Writes after unsharing: %zu, Failed copies: %zu",
+            stats->cowFaults, stats->pagesCopied, stats->cowReuses, stats->failedCopies);
+    info(logMsg);
+}
+
+// Snapshot the running fragmentation counters in O(1)
+FragmentationStats getFragmentationStats(MemoryManager *manager)
+{
+    FragmentationStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (!manager)
+        return stats;
+
+    stats.freeBlockBytes = manager->freeBlockBytes;
+    stats.freeBlockCount = manager->freeBlockCount;
+    stats.largestFreeBlock = manager->freeBlockCount > 0 ? manager->freeBlockHeap[0]->size : 0;
+    stats.allocatedBlockBytes = manager->allocatedBlockBytes;
+    stats.wastedBlockBytes = manager->wastedBlockBytes;
+    stats.allocatedFrameBytes = manager->pageFrames ? (manager->totalPages - manager->freePages) * manager->pageSize : 0;
+    stats.wastedFrameBytes = stats.allocatedFrameBytes - manager->frameUsedBytes;
+
+    // External fragmentation is measured as 1 - (largest free block / total free memory)
+    if (stats.freeBlockBytes > 0)
+    {
+        stats.externalFragmentation = 1.0 - ((double)stats.largestFreeBlock / stats.freeBlockBytes);
+    }
+
+    // Internal fragmentation is measured as wasted space / total allocated space
+    if (manager->strategy == PAGING || manager->strategy == HYBRID)
+    {
+        if (stats.allocatedFrameBytes > 0)
+        {
+            stats.internalFragmentation = (double)stats.wastedFrameBytes / stats.allocatedFrameBytes;
+        }
+    }
+    else if (stats.allocatedBlockBytes > 0)
+    {
+        stats.internalFragmentation = (double)stats.wastedBlockBytes / stats.allocatedBlockBytes;
+    }
+
+    return stats;
+}
+
+// Usage and fragmentation for each page size in use: base pages, then huge pages when enabled
+int getPageSizeStats(MemoryManager *manager, PageSizeStats *stats, int maxSizes)
+{
+    if (!manager || !manager->pageFrames || maxSizes < 1)
+        return 0;
+
+    size_t hugeFrames = manager->hugePageSize / manager->pageSize;
+    size_t freeBytes = manager->freePages * manager->pageSize;
+
+    // Base pages (slab frames included); every free frame can back one
+    memset(&stats[0], 0, sizeof(PageSizeStats));
+    stats[0].pageSize = manager->pageSize;
+    stats[0].pagesAllocated = manager->totalPages - manager->freePages - manager->hugePagesAllocated * hugeFrames;
+    stats[0].freePages = manager->freePages;
+    stats[0].allocatedBytes = stats[0].pagesAllocated * manager->pageSize;
+    stats[0].usedBytes = manager->frameUsedBytes - manager->hugeFrameUsedBytes;
+    stats[0].wastedBytes = stats[0].allocatedBytes - stats[0].usedBytes;
+    if (stats[0].allocatedBytes > 0)
+    {
+        stats[0].internalFragmentation = (double)stats[0].wastedBytes / stats[0].allocatedBytes;
+    }
+
+    if (manager->hugePageSize == 0 || maxSizes < 2)
+        return 1;
+
+    // Huge pages need aligned free runs, so scattered free frames count against them
+    memset(&stats[1], 0, sizeof(PageSizeStats));
+    stats[1].pageSize = manager->hugePageSize;
+    stats[1].pagesAllocated = manager->hugePagesAllocated;
+    stats[1].freePages = countFreeAlignedRuns(manager, hugeFrames);
+    stats[1].allocatedBytes = manager->hugePagesAllocated * manager->hugePageSize;
+    stats[1].usedBytes = manager->hugeFrameUsedBytes;
+    stats[1].wastedBytes = stats[1].allocatedBytes - stats[1].usedBytes;
+    if (stats[1].allocatedBytes > 0)
+    {
+        stats[1].internalFragmentation = (double)stats[1].wastedBytes / stats[1].allocatedBytes;
+    }
+    if (freeBytes > 0)
+    {
+        stats[1].externalFragmentation = 1.0 - (double)(stats[1].freePages * manager->hugePageSize) / freeBytes;
+    }
+
+    return 2;
+}
+
+// Calculate and report fragmentation from the running counters
+void calculateFragmentation(MemoryManager *manager)
+{
+    if (!manager)
+        return;
+
+    char header[100];
+    sprintf(header, "======== Fragmentation Analysis ========");
+    info(header);
+
+    FragmentationStats stats = getFragmentationStats(manager);
+    manager->externalFragmentation = stats.externalFragmentation;
+    manager->internalFragmentation = stats.internalFragmentation;
+
+    char logMsg[200];
+    switch (manager->strategy)
+    {
+    case SEGMENTATION:
+        sprintf(logMsg, "Segmentation: External Fragmentation: %.2f%% (Free blocks: %d, Total free: %zu, Largest free: %zu)",
+                manager->externalFragmentation * 100, stats.freeBlockCount, stats.freeBlockBytes, stats.largestFreeBlock);
+        info(logMsg);
+        break;
+
+    case PAGING:
+        sprintf(logMsg, "Paging: Internal Fragmentation: %.2f%% (Wasted: %zu bytes out of %zu allocated)",
+                manager->internalFragmentation * 100, stats.wastedFrameBytes, stats.allocatedFrameBytes);
+        info(logMsg);
+        break;
+
+    case HYBRID:
+        sprintf(logMsg, "Hybrid: External Fragmentation: %.2f%%, Internal Fragmentation: %.2f%%",
+                manager->externalFragmentation * 100, manager->internalFragmentation * 100);
+        info(logMsg);
+        break;
+
+    case BUDDY:
+    case TLSF:
+        // External fragmentation across free blocks, internal from rounding requests up to the block size
+        sprintf(logMsg, "%s: External Fragmentation: %.2f%% (Free blocks: %d, Largest free: %zu), Internal Fragmentation: %.2f%% (Wasted: %zu bytes)",
+                memoryStrategyName(manager->strategy), manager->externalFragmentation * 100, stats.freeBlockCount,
+                stats.largestFreeBlock, manager->internalFragmentation * 100, stats.wastedBlockBytes);
+        info(logMsg);
+        break;
+    }
+
+    // Break frame fragmentation down per page size once huge pages are in play
+    if (manager->hugePageSize > 0)
+    {
+        PageSizeStats sizeStats[2];
+        int sizes = getPageSizeStats(manager, sizeStats, 2);
+        for (int i = 0; i < sizes; i++)
+        {
+            sprintf(logMsg, "  %zu-byte pages: %zu allocated, %zu free, Internal Fragmentation: %.2f%% (Wasted: %zu bytes), External Fragmentation: %.2f%%",
+                    sizeStats[i].pageSize, sizeStats[i].pagesAllocated, sizeStats[i].freePages,
+                    sizeStats[i].internalFragmentation * 100, sizeStats[i].wastedBytes, sizeStats[i].externalFragmentation * 100);
+            info(logMsg);
+        }
+    }
+}
+
+// Print memory statistics
+void printMemoryStats(MemoryManager *manager)
+{
+    if (!manager)
+        return;
+
+    char header[100];
+    sprintf(header, "======== Memory Manager Statistics ========");
+    info(header);
+
+    char strategyMsg[100];
+    sprintf(strategyMsg, "Strategy: %s", memoryStrategyName(manager->strategy));
+    info(strategyMsg);
+
+    char memStats[150];
+    sprintf(memStats, "Total memory: %zu bytes | Used: %zu bytes (%.1f%%) | Free: %zu bytes (%.1f%%)",
+            manager->totalMemory,
+            manager->usedMemory,
+            ((double)manager->usedMemory / manager->totalMemory) * 100,
+            manager->freeMemory,
+            ((double)manager->freeMemory / manager->totalMemory) * 100);
+    info(memStats);
+
+    // Calculate updated fragmentation statistics
+    calculateFragmentation(manager);
+
+    if (manager->cowStats.forks > 0)
+    {
+        char cowMsg[150];
+        sprintf(cowMsg, "Copy-on-write: %zu shared pages save %zu bytes, %zu COW faults",
+                manager->cowStats.sharedPages, manager->cowStats.sharedPages * manager->pageSize, manager->cowStats.cowFaults);
+        info(cowMsg);
+    }
+
+    char procHeader[100];
+    sprintf(procHeader, "---- Active Processes: %d ----", manager->processCount);
+    info(procHeader);
+
+    for (int i = 0; i < manager->processSlots; i++)
+    {
+        Process *proc = &manager->processes[i];
+        if (proc->state == PROCESS_FREE)
+            continue;
+
+        char procInfo[150];
+        sprintf(procInfo, "Process %d: Name: %s, Size: %zu bytes",
+                proc->id, proc->name, proc->size);
+        info(procInfo);
+
+        switch (manager->strategy)
+        {
+        case SEGMENTATION:
+        case BUDDY:
+        case TLSF:
+            // Print segment information
+            info("  Segments:");
+            MemorySegment *seg = proc->segments;
+            while (seg)
+            {
+                char segInfo[150];
+                sprintf(segInfo, "  - %s segment: Address: %zu, Size: %zu bytes",
+                        seg->segmentType, seg->address, seg->size);
+                info(segInfo);
+                seg = seg->nextInProcess;
+            }
+            break;
+
+        case PAGING:
+            // Print page table information
+            if (proc->pageTable)
+            {
+                char pageInfo[150];
+                sprintf(pageInfo, "  Pages: %d pages (%zu bytes per page), page table: %zu bytes (%zu nodes, %zu leaves)",
+                        proc->pageTable->pageCount, manager->pageSize, pageTableMemory(proc->pageTable),
+                        proc->pageTable->nodeCount, proc->pageTable->leafCount);
+                info(pageInfo);
+            }
+            break;
+
+        case HYBRID:
+            // Print both segment and page information
+            MemorySegment *hybridSeg = proc->segments;
+            if (hybridSeg)
+            {
+                info("  Segments:");
+                while (hybridSeg)
+                {
+                    char segInfo[150];
+                    sprintf(segInfo, "  - %s segment: Address: %zu, Size: %zu bytes",
+                            hybridSeg->segmentType, hybridSeg->address, hybridSeg->size);
+                    info(segInfo);
+                    hybridSeg = hybridSeg->nextInProcess;
+                }
+            }
+
+            if (proc->pageTable)
+            {
+                char pageInfo[150];
+                sprintf(pageInfo, "  Pages: %d pages (%zu bytes per page), page table: %zu bytes (%zu nodes, %zu leaves)",
+                        proc->pageTable->pageCount, manager->pageSize, pageTableMemory(proc->pageTable),
+                        proc->pageTable->nodeCount, proc->pageTable->leafCount);
+                info(pageInfo);
+            }
+            break;
+        }
+    }
+
+    if (manager->analytics)
+    {
+        printAccessAnalytics(manager->analytics);
+    }
+
+    char footer[100];
+    sprintf(footer, "==========================================");
+    info(footer);
+}
+
+// Name shown for the owner of an allocated page frame
+static const char *frameOwnerName(MemoryManager *manager, Page *frame)
+{
+    if (frame->processId == SLAB_PROCESS_ID)
+        return "slab";
+    if (frame->processId == SHARED_PROCESS_ID)
+        return "shared";
+    return manager->processes[PROCESS_SLOT(frame->processId)].name;
+}
+
+// Visualize the memory layout
+void visualizeMemory(MemoryManager *manager)
+{
+    if (!manager)
+        return;
+
+    char header[100];
+    sprintf(header, "======== Memory Visualization ========");
+    info(header);
+
+    switch (manager->strategy)
+    {
+    case SEGMENTATION:
+    case BUDDY:
+    case TLSF:
+    {
+        char layoutMsg[100];
+        sprintf(layoutMsg, "Memory Layout (%s):", memoryStrategyName(manager->strategy));
+        info(layoutMsg);
+        info("| Address | Size     | Status    | Process   | Type     |");
+        info("|---------|----------|-----------|-----------|----------|");
+
+        MemorySegment *current = manager->segmentList;
+        while (current)
+        {
+            char segmentInfo[100];
+            sprintf(segmentInfo, "| %-7zu | %-8zu | %-9s | %-9s | %-8s |",
+                    current->address,
+                    current->size,
+                    current->allocated ? "Allocated" : "Free",
+                    current->allocated ? current->processName : "-",
+                    current->allocated ? current->segmentType : "-");
+            info(segmentInfo);
+
+            current = current->next;
+        }
+        break;
+    }
+
+    case PAGING:
+    {
+        info("Memory Layout (Paging):");
+        info("| Frame # | Status    | Process   | Used Bytes |");
+        info("|---------|-----------|-----------|------------|");
+
+        for (size_t i = 0; i < manager->totalPages; i++)
+        {
+            char frameInfo[100];
+            sprintf(frameInfo, "| %-7zu | %-9s | %-9s | %-10zu |",
+                    i,
+                    manager->pageFrames[i].allocated ? "Allocated" : "Free",
+                    manager->pageFrames[i].allocated ? frameOwnerName(manager, &manager->pageFrames[i]) : "-",
+                    manager->pageFrames[i].allocated ? manager->pageFrames[i].usedBytes : 0);
+            info(frameInfo);
+        }
+        break;
+    }
+
+    case HYBRID:
+    {
+        info("Memory Layout (Hybrid - Segments):");
+        info("| Address | Size     | Status    | Process   | Type     |");
+        info("|---------|----------|-----------|-----------|----------|");
+
+        MemorySegment *current = manager->segmentList;
+        while (current)
+        {
+            char segmentInfo[100];
+            sprintf(segmentInfo, "| %-7zu | %-8zu | %-9s | %-9s | %-8s |",
+                    current->address,
+                    current->size,
+                    current->allocated ? "Allocated" : "Free",
+                    current->allocated ? current->processName : "-",
+                    current->allocated ? current->segmentType : "-");
+            info(segmentInfo);
+
+            current = current->next;
+        }
+
+        info("\nMemory Layout (Hybrid - Pages):");
+        info("| Frame # | Status    | Process   | Used Bytes |");
+        info("|---------|-----------|-----------|------------|");
+
+        for (size_t i = 0; i < manager->totalPages; i++)
+        {
+            char frameInfo[100];
+            sprintf(frameInfo, "| %-7zu | %-9s | %-9s | %-10zu |",
+                    i,
+                    manager->pageFrames[i].allocated ? "Allocated" : "Free",
+                    manager->pageFrames[i].allocated ? frameOwnerName(manager, &manager->pageFrames[i]) : "-",
+                    manager->pageFrames[i].allocated ? manager->pageFrames[i].usedBytes : 0);
+            info(frameInfo);
+        }
+        break;
+    }
+    }
+
+    char footer[100];
+    sprintf(footer, "=====================================");
+    info(footer);
+}
+
+// Visualize the memory layout with a graphical representation
+void visualizeMemoryGraphically(MemoryManager *manager)
+{
+    if (!manager)
+        return;
+
+    char header[100];
+    sprintf(header, "======== Memory Visualization (Graphical) ========");
+    info(header);
+
+    // Define the display width for visualization
+    const int displayWidth = 80;
+    char visualLine[81];
+
+    switch (manager->strategy)
+    {
+    case SEGMENTATION:
+    case BUDDY:
+    case TLSF:
+    {
+        char layoutMsg[100];
+        sprintf(layoutMsg, "Memory Layout (%s):", memoryStrategyName(manager->strategy));
+        info(layoutMsg);
+        info("Each character represents a memory unit");
+        info("Legend: # = Allocated, . = Free");
+
+        // Count total memory units to scale properly
+        size_t totalMemSize = manager->totalMemory;
+        double scaleFactor = (double)displayWidth / totalMemSize;
+
+        // Initialize the display
+        for (int i = 0; i < displayWidth; i++)
+            visualLine[i] = ' ';
+        visualLine[displayWidth] = '\0';
+
+        // Fill in segments
+        MemorySegment *current = manager->segmentList;
+        while (current)
+        {
+            int startPos = (int)(current->address * scaleFactor);
+            int endPos = (int)((current->address + current->size) * scaleFactor);
+
+            // Ensure we don't overflow the buffer
+            if (startPos >= displayWidth)
+                startPos = displayWidth - 1;
+            endPos = (endPos >= displayWidth) ? displayWidth - 1 : endPos;
+
+            char blockChar = current->allocated ? '#' : '.';
+
+            for (int i = startPos; i <= endPos && i < displayWidth; i++)
+                visualLine[i] = blockChar;
+
+            current = current->next;
+        }
+
+        // Print memory visualization
+        info(visualLine);
+
+        // Show markers for addresses
+        info("0                                                                              100%%");
+
+        // Show process labels beneath the visualization
+        current = manager->segmentList;
+        while (current)
+        {
+            if (current->allocated)
+            {
+                // Calculate position for the label
+                int labelPos = (int)(current->address * scaleFactor);
+                int labelEndPos = (int)((current->address + current->size) * scaleFactor);
+                int centerPos = (labelPos + labelEndPos) / 2;
+
+                // Don't print if segment is too small
+                if (labelEndPos - labelPos > 3)
+                {
+                    // Create a label line
+                    for (int i = 0; i < displayWidth; i++)
+                        visualLine[i] = ' ';
+
+                    // Place the process name at the center position
+                    int nameLen = strlen(current->processName);
+                    int startNamePos = centerPos - nameLen / 2;
+
+                    // Make sure we stay within bounds
+                    if (startNamePos < 0)
+                        startNamePos = 0;
+                    if (startNamePos + nameLen >= displayWidth)
+                        startNamePos = displayWidth - nameLen - 1;
+
+                    // Insert the process name
+                    for (int i = 0; i < nameLen && startNamePos + i < displayWidth; i++)
+                        visualLine[startNamePos + i] = current->processName[i];
+
+                    info(visualLine);
+                }
+            }
+            current = current->next;
+        }
+        break;
+    }
+
+    case PAGING:
+    {
+        info("Memory Layout (Paging):");
+        info("Each character represents a page frame");
+        info("Legend: # = Allocated, . = Free");
+
+        // Initialize the display
+        int totalPages = manager->totalPages;
+        int pagesPerRow = displayWidth;
+
+        // If we have more pages than can fit in one row
+        if (totalPages > displayWidth)
+            pagesPerRow = displayWidth;
+
+        int rowCount = (totalPages + pagesPerRow - 1) / pagesPerRow;
+
+        for (int row = 0; row < rowCount; row++)
+        {
+            // Initialize the line
+            for (int i = 0; i < displayWidth; i++)
+                visualLine[i] = ' ';
+            visualLine[displayWidth] = '\0';
+
+            // Fill the line with page frames
+            for (int i = 0; i < pagesPerRow && (row * pagesPerRow + i) < totalPages; i++)
+            {
+                size_t pageNum = row * pagesPerRow + i;
+                visualLine[i] = manager->pageFrames[pageNum].allocated ? '#' : '.';
+            }
+
+            info(visualLine);
+        }
+
+        // Show process labels beneath the visualization
+        info("Process Ownership:");
+
+        for (int i = 0; i < manager->processSlots; i++)
         {
             Process *proc = &manager->processes[i];
-            if (proc->pageTable == NULL)
+            if (proc->state == PROCESS_FREE || proc->pageTable == NULL)
                 continue;
 
-            // Find all pages associated with this process
-            for (int row = 0; row < rowCount; row++)
+            // Find all pages associated with this process
+            for (int row = 0; row < rowCount; row++)
+            {
+                // Reset line
+                for (int j = 0; j < displayWidth; j++)
+                    visualLine[j] = ' ';
+
+                bool hasPageInRow = false;
+
+                // Check each page in this row
+                for (int col = 0; col < pagesPerRow && (row * pagesPerRow + col) < totalPages; col++)
+                {
+                    size_t pageNum = row * pagesPerRow + col;
+
+                    // Check if this page belongs to this process
+                    if (manager->pageFrames[pageNum].allocated &&
+                        manager->pageFrames[pageNum].processId == proc->id)
+                    {
+                        visualLine[col] = 'P';
+                        hasPageInRow = true;
+                    }
+                }
+
+                if (hasPageInRow)
+                {
+                    char label[100];
+                    sprintf(label, " Process %s", proc->name);
+
+                    // Append process name to the visualization
+                    int nameLen = strlen(label);
+                    for (int j = 0; j < nameLen && j + pagesPerRow + 1 < displayWidth; j++)
+                        visualLine[pagesPerRow + 1 + j] = label[j];
+
+                    info(visualLine);
+                }
+            }
+        }
+        break;
+    }
+
+    case HYBRID:
+    {
+        info("Memory Layout (Hybrid):");
+        info("Segmentation area:");
+        info("Each character represents a memory unit");
+        info("Legend: # = Allocated, . = Free");
+
+        // Visualize segmentation area
+        size_t segMemSize = manager->totalMemory / 2; // Assume half for segmentation
+        double scaleFactor = (double)displayWidth / segMemSize;
+
+        // Initialize the display
+        for (int i = 0; i < displayWidth; i++)
+            visualLine[i] = ' ';
+        visualLine[displayWidth] = '\0';
+
+        // Fill in segments
+        MemorySegment *current = manager->segmentList;
+        while (current)
+        {
+            int startPos = (int)(current->address * scaleFactor);
+            int endPos = (int)((current->address + current->size) * scaleFactor);
+
+            // Ensure we don't overflow the buffer
+            endPos = (endPos >= displayWidth) ? displayWidth - 1 : endPos;
+
+            char blockChar = current->allocated ? '#' : '.';
+
+            for (int i = startPos; i <= endPos && i < displayWidth; i++)
+                visualLine[i] = blockChar;
+
+            current = current->next;
+        }
+
+        // Print memory visualization for segmentation
+        info(visualLine);
+
+        // Visualize paging area
+        info("\nPaging area:");
+        info("Each character represents a page frame");
+        info("Legend: # = Allocated, . = Free");
+
+        // Initialize the display
+        int totalPages = manager->totalPages;
+        int pagesPerRow = displayWidth;
+
+        int rowCount = (totalPages + pagesPerRow - 1) / pagesPerRow;
+
+        for (int row = 0; row < rowCount; row++)
+        {
+            // Initialize the line
+            for (int i = 0; i < displayWidth; i++)
+                visualLine[i] = ' ';
+
+            // Fill the line with page frames
+            for (int i = 0; i < pagesPerRow && (row * pagesPerRow + i) < totalPages; i++)
+            {
+                size_t pageNum = row * pagesPerRow + i;
+                visualLine[i] = manager->pageFrames[pageNum].allocated ? '#' : '.';
+            }
+
+            info(visualLine);
+        }
+
+        break;
+    }
+    }
+
+    // Show fragmentation statistics
+    char fragMsg[150];
+    switch (manager->strategy)
+    {
+    case SEGMENTATION:
+        sprintf(fragMsg, "External Fragmentation: %.2f%%", manager->externalFragmentation * 100);
+        break;
+    case PAGING:
+        sprintf(fragMsg, "Internal Fragmentation: %.2f%%", manager->internalFragmentation * 100);
+        break;
+    case HYBRID:
+    case BUDDY:
+    case TLSF:
+        sprintf(fragMsg, "External Fragmentation: %.2f%%, Internal Fragmentation: %.2f%%",
+                manager->externalFragmentation * 100,
+                manager->internalFragmentation * 100);
+        break;
+    }
+    info(fragMsg);
+
+    char footer[100];
+    sprintf(footer, "===============================================");
+    info(footer);
+}
+
+#define SNAPSHOT_BYTE_ORDER 0x0102030405060708ULL
+#define SNAPSHOT_NO_SEGMENT UINT64_MAX
+#define SNAPSHOT_DEMAND_PAGING 0x1
+#define SNAPSHOT_COMPACT_ON_FAILURE 0x2
+
+// Snapshot files: a header followed by arrays of fixed-size records, every one a multiple of 8 bytes at an
+// 8-byte aligned offset, so a mapped file is read in place. Addresses stand in for segment pointers
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize; // Rejects files written by a build with another record layout
+    uint64_t byteOrder;  // SNAPSHOT_BYTE_ORDER as the writer stored it
+
+    // Configuration
+    uint32_t strategy;
+    uint32_t placement;
+    uint32_t replacement;
+    uint32_t flags; // SNAPSHOT_DEMAND_PAGING, SNAPSHOT_COMPACT_ON_FAILURE
+    int32_t maxProcesses;
+    int32_t processSlots;
+    int32_t freeProcessSlotCount;
+    uint32_t reserved;
+    uint64_t totalMemory;
+    uint64_t pageSize;
+    uint64_t hugePageSize;
+
+    // Running counters (those the segments and frames determine are rebuilt from them)
+    uint64_t freeMemory;
+    uint64_t usedMemory;
+    uint64_t arcTarget;
+    uint64_t nextFitAddress; // SNAPSHOT_NO_SEGMENT: NULL
+    uint64_t compactAddress;
+    double externalFragmentation;
+    double internalFragmentation;
+    PagingStats pagingStats;
+    CowStats cowStats;
+
+    // Sections (the process section holds processSlots records)
+    uint64_t segmentCount;
+    uint64_t segmentOffset;
+    uint64_t frameCount;
+    uint64_t frameOffset;
+    uint64_t processOffset;
+    uint64_t entryCount;
+    uint64_t entryOffset;
+    uint64_t residencyCount;
+    uint64_t residencyOffset;
+} SnapshotHeader;
+
+// A segment or block, in address order
+typedef struct
+{
+    uint64_t address;
+    uint64_t size;
+    uint64_t usedBytes;
+    uint64_t nextInProcess; // Address of the next segment owned by the same process (SNAPSHOT_NO_SEGMENT: none)
+    uint64_t nextFree;      // Address of the next segment on the same free list (SNAPSHOT_NO_SEGMENT: none)
+    int32_t id;
+    int32_t processId;
+    uint32_t allocated;
+    uint32_t reserved;
+    char processName[32];
+    char segmentType[16];
+} SnapshotSegment;
+
+// A physical frame, in frame number order
+typedef struct
+{
+    uint64_t usedBytes;
+    int32_t processId;
+    int32_t refCount;
+    uint8_t allocated;
+    uint8_t huge;
+    uint8_t reserved[6];
+} SnapshotFrame;
+
+// A process table slot, in slot order; its page table entries follow the previous slots' in the entry section
+typedef struct
+{
+    uint64_t size;
+    uint64_t firstSegment; // Address of the head of the process's segment chain (SNAPSHOT_NO_SEGMENT: none)
+    uint64_t entryCount;
+    int32_t id;
+    uint32_t state;
+    uint32_t generation;
+    uint32_t allocStrategy;
+    int32_t segmentCount;
+    int32_t pageCount;        // -1: no page table
+    int32_t freeSlotPosition; // Position on the free-slot stack (-1: not on it)
+    uint32_t reserved;
+    char name[32];
+} SnapshotProcess;
+
+// A mapped page table entry, in virtual page order
+typedef struct
+{
+    uint64_t vpage;
+    uint64_t frameNumber;
+    uint64_t usedBytes;
+    uint8_t allocated;
+    uint8_t huge;
+    uint8_t readOnly;
+    uint8_t dirty;
+    uint8_t referenced;
+    uint8_t reserved[3];
+} SnapshotEntry;
+
+// A residency list position, oldest first, for each list in turn
+typedef struct
+{
+    uint64_t vpage;
+    int32_t processId;
+    uint32_t list;
+} SnapshotResidency;
+
+// Write the mapped entries of a page table subtree in virtual page order
+static void writeSnapshotEntries(FILE *file, void *node, int level, uint64_t *count)
+{
+    if (!node)
+    {
+        return;
+    }
+
+    if (level > 1)
+    {
+        PageTableNode *interior = (PageTableNode *)node;
+        for (int i = 0; i < PAGE_TABLE_FANOUT; i++)
+        {
+            writeSnapshotEntries(file, interior->children[i], level - 1, count);
+        }
+        return;
+    }
+
+    Page *leaf = (Page *)node;
+    for (int i = 0; i < PAGE_TABLE_FANOUT; i++)
+    {
+        Page *entry = &leaf[i];
+        if (entry->processId < 0)
+        {
+            continue;
+        }
+
+        SnapshotEntry record;
+        memset(&record, 0, sizeof(record));
+        record.vpage = entry->id;
+        record.frameNumber = entry->frameNumber;
+        record.usedBytes = entry->usedBytes;
+        record.allocated = entry->allocated;
+        record.huge = entry->huge;
+        record.readOnly = entry->readOnly;
+        record.dirty = entry->dirty;
+        record.referenced = entry->referenced;
+        fwrite(&record, sizeof(record), 1, file);
+        (*count)++;
+    }
+}
+
+// Save the segment list, frame table and process table (page tables and replacement lists included) to a
+// snapshot file. The TLB, swap device, analytics, trace recorder and slab caches attached by the caller are
+// not part of it, so a snapshot of a manager with slab frames is refused
+bool saveMemoryManager(MemoryManager *manager, const char *path)
+{
+    for (size_t i = 0; manager->pageFrames && i < manager->totalPages; i++)
+    {
+        if (manager->pageFrames[i].processId == SLAB_PROCESS_ID)
+        {
+            error("Cannot snapshot a memory manager whose frames are held by slab caches");
+            return false;
+        }
+    }
+
+    uint64_t *entryCounts = (uint64_t *)calloc(manager->processSlots > 0 ? manager->processSlots : 1, sizeof(uint64_t));
+    int32_t *freeSlotPositions = (int32_t *)malloc((manager->processSlots > 0 ? manager->processSlots : 1) * sizeof(int32_t));
+    if (!entryCounts || !freeSlotPositions)
+    {
+        error("Failed to allocate memory for snapshot bookkeeping");
+        free(entryCounts);
+        free(freeSlotPositions);
+        return false;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        char errMsg[300];
+        sprintf(errMsg, "Failed to open snapshot file %.256s for writing", path);
+        error(errMsg);
+        free(entryCounts);
+        free(freeSlotPositions);
+        return false;
+    }
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.strategy = manager->strategy;
+    header.placement = manager->placement;
+    header.replacement = manager->replacement;
+    header.flags = (manager->demandPaging ? SNAPSHOT_DEMAND_PAGING : 0) | (manager->compactOnFailure ? SNAPSHOT_COMPACT_ON_FAILURE : 0);
+    header.maxProcesses = manager->maxProcesses;
+    header.processSlots = manager->processSlots;
+    header.freeProcessSlotCount = manager->freeProcessSlotCount;
+    header.totalMemory = manager->totalMemory;
+    header.pageSize = manager->pageSize;
+    header.hugePageSize = manager->hugePageSize;
+    header.freeMemory = manager->freeMemory;
+    header.usedMemory = manager->usedMemory;
+    header.arcTarget = manager->arcTarget;
+    header.nextFitAddress = manager->nextFitCursor ? manager->nextFitCursor->address : SNAPSHOT_NO_SEGMENT;
+    header.compactAddress = manager->compactCursor ? manager->compactCursor->address : SNAPSHOT_NO_SEGMENT;
+    header.externalFragmentation = manager->externalFragmentation;
+    header.internalFragmentation = manager->internalFragmentation;
+    header.pagingStats = manager->pagingStats;
+    header.cowStats = manager->cowStats;
+
+    // The header is rewritten once the section sizes are known
+    fwrite(&header, sizeof(header), 1, file);
+    uint64_t offset = sizeof(header);
+
+    header.segmentOffset = offset;
+    for (MemorySegment *segment = manager->segmentList; segment; segment = segment->next)
+    {
+        SnapshotSegment record;
+        memset(&record, 0, sizeof(record));
+        record.address = segment->address;
+        record.size = segment->size;
+        record.usedBytes = segment->usedBytes;
+        record.nextInProcess = segment->allocated && segment->nextInProcess ? segment->nextInProcess->address : SNAPSHOT_NO_SEGMENT;
+        record.nextFree = !segment->allocated && segment->nextFree ? segment->nextFree->address : SNAPSHOT_NO_SEGMENT;
+        record.id = segment->id;
+        record.processId = segment->processId;
+        record.allocated = segment->allocated;
+        snprintf(record.processName, sizeof(record.processName), "%s", segment->processName);
+        snprintf(record.segmentType, sizeof(record.segmentType), "%s", segment->segmentType);
+        fwrite(&record, sizeof(record), 1, file);
+        header.segmentCount++;
+    }
+    offset += header.segmentCount * sizeof(SnapshotSegment);
+
+    header.frameOffset = offset;
+    header.frameCount = manager->pageFrames ? manager->totalPages : 0;
+    for (size_t i = 0; i < header.frameCount; i++)
+    {
+        Page *frame = &manager->pageFrames[i];
+        SnapshotFrame record;
+        memset(&record, 0, sizeof(record));
+        record.usedBytes = frame->usedBytes;
+        record.processId = frame->processId;
+        record.refCount = frame->refCount;
+        record.allocated = frame->allocated;
+        record.huge = frame->huge;
+        fwrite(&record, sizeof(record), 1, file);
+    }
+    offset += header.frameCount * sizeof(SnapshotFrame);
+
+    header.entryOffset = offset;
+    for (int i = 0; i < manager->processSlots; i++)
+    {
+        Process *proc = &manager->processes[i];
+        if (proc->state != PROCESS_FREE && proc->pageTable)
+        {
+            writeSnapshotEntries(file, proc->pageTable->root, PAGE_TABLE_LEVELS, &entryCounts[i]);
+            header.entryCount += entryCounts[i];
+        }
+    }
+    offset += header.entryCount * sizeof(SnapshotEntry);
+
+    for (int i = 0; i < manager->processSlots; i++)
+    {
+        freeSlotPositions[i] = -1;
+    }
+    for (int i = 0; i < manager->freeProcessSlotCount; i++)
+    {
+        freeSlotPositions[manager->freeProcessSlots[i]] = i;
+    }
+
+    header.processOffset = offset;
+    for (int i = 0; i < manager->processSlots; i++)
+    {
+        Process *proc = &manager->processes[i];
+        bool live = proc->state != PROCESS_FREE;
+
+        SnapshotProcess record;
+        memset(&record, 0, sizeof(record));
+        record.size = proc->size;
+        record.firstSegment = live && proc->segments ? proc->segments->address : SNAPSHOT_NO_SEGMENT;
+        record.entryCount = entryCounts[i];
+        record.id = proc->id;
+        record.state = proc->state;
+        record.generation = proc->generation;
+        record.allocStrategy = proc->allocStrategy;
+        record.segmentCount = live ? proc->segmentCount : 0;
+        record.pageCount = live && proc->pageTable ? proc->pageTable->pageCount : -1;
+        record.freeSlotPosition = freeSlotPositions[i];
+        snprintf(record.name, sizeof(record.name), "%s", proc->name);
+        fwrite(&record, sizeof(record), 1, file);
+    }
+    offset += (uint64_t)manager->processSlots * sizeof(SnapshotProcess);
+
+    header.residencyOffset = offset;
+    for (int list = RESIDENCY_T1; list < RESIDENCY_LIST_COUNT; list++)
+    {
+        for (Page *entry = manager->residencyHead[list]; entry; entry = entry->listNext)
+        {
+            SnapshotResidency record;
+            memset(&record, 0, sizeof(record));
+            record.vpage = entry->id;
+            record.processId = entry->processId;
+            record.list = (uint32_t)list;
+            fwrite(&record, sizeof(record), 1, file);
+            header.residencyCount++;
+        }
+    }
+    offset += header.residencyCount * sizeof(SnapshotResidency);
+
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, file);
+
+    bool ok = !ferror(file);
+    ok = fclose(file) == 0 && ok;
+    free(entryCounts);
+    free(freeSlotPositions);
+
+    char logMsg[400];
+    if (!ok)
+    {
+        sprintf(logMsg, "Failed to write snapshot file %.256s", path);
+        error(logMsg);
+        return false;
+    }
+
+    sprintf(logMsg, "Saved snapshot to %.256s: %llu segments, %llu frames, %d processes, %llu bytes",
+            path, (unsigned long long)header.segmentCount, (unsigned long long)header.frameCount, manager->processCount,
+            (unsigned long long)offset);
+    info(logMsg);
+
+    return true;
+}
+
+// Whether a section of count records of recordSize bytes lies inside the file
+static bool snapshotSectionValid(uint64_t offset, uint64_t count, size_t recordSize, size_t fileSize)
+{
+    return offset % 8 == 0 && offset >= sizeof(SnapshotHeader) && offset <= fileSize &&
+           count <= (fileSize - offset) / recordSize;
+}
+
+// Check the header's identity, configuration and section bounds before anything else is read
+static bool snapshotHeaderValid(const SnapshotHeader *header, size_t fileSize, const char *path)
+{
+    char errMsg[400];
+    if (fileSize < sizeof(SnapshotHeader) || memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0)
+    {
+        sprintf(errMsg, "%.256s is not a memory manager snapshot", path);
+        error(errMsg);
+        return false;
+    }
+
+    if (header->version != SNAPSHOT_VERSION || header->headerSize != sizeof(SnapshotHeader) ||
+        header->byteOrder != SNAPSHOT_BYTE_ORDER)
+    {
+        sprintf(errMsg, "Snapshot %.256s has version %u; this build reads version %u on this architecture",
+                path, header->version, SNAPSHOT_VERSION);
+        error(errMsg);
+        return false;
+    }
+
+    size_t hugeFrames = header->pageSize > 0 ? header->hugePageSize / header->pageSize : 0;
+    bool paging = header->strategy == PAGING || header->strategy == HYBRID;
+    bool valid = header->strategy <= TLSF && header->placement <= PLACEMENT_SEGREGATED_FIT &&
+                 header->replacement <= REPLACEMENT_ARC && header->totalMemory > 0 &&
+                 (!paging || header->pageSize > 0) && header->frameCount == (paging ? header->totalMemory / header->pageSize : 0) &&
+                 (header->hugePageSize == 0 || (paging && header->hugePageSize % header->pageSize == 0 && hugeFrames >= 2 &&
+                                                (hugeFrames & (hugeFrames - 1)) == 0 && hugeFrames <= header->totalMemory / header->pageSize)) &&
+                 header->maxProcesses > 0 && header->maxProcesses <= PROCESS_MAX_SLOTS &&
+                 header->processSlots >= 0 && header->processSlots <= header->maxProcesses &&
+                 header->freeProcessSlotCount >= 0 && header->freeProcessSlotCount <= header->processSlots &&
+                 snapshotSectionValid(header->segmentOffset, header->segmentCount, sizeof(SnapshotSegment), fileSize) &&
+                 snapshotSectionValid(header->frameOffset, header->frameCount, sizeof(SnapshotFrame), fileSize) &&
+                 snapshotSectionValid(header->processOffset, (uint64_t)header->processSlots, sizeof(SnapshotProcess), fileSize) &&
+                 snapshotSectionValid(header->entryOffset, header->entryCount, sizeof(SnapshotEntry), fileSize) &&
+                 snapshotSectionValid(header->residencyOffset, header->residencyCount, sizeof(SnapshotResidency), fileSize);
+    if (!valid)
+    {
+        sprintf(errMsg, "Snapshot %.256s has an invalid header", path);
+        error(errMsg);
+    }
+    return valid;
+}
+
+// Drop the free layout a new manager starts with, leaving the segment list and every free index empty
+static void clearSegmentLayout(MemoryManager *manager)
+{
+    MemorySegment *segment = manager->segmentList;
+    while (segment)
+    {
+        MemorySegment *next = segment->next;
+        releaseSegmentNode(manager, segment);
+        segment = next;
+    }
+    manager->segmentList = NULL;
+    manager->nextFitCursor = NULL;
+    manager->compactCursor = NULL;
+
+    memset(manager->freeBins, 0, sizeof(manager->freeBins));
+    manager->freeBinMap = 0;
+    manager->freeTree = NULL;
+
+    size_t blockCount = manager->buddyMinBlock > 0 ? manager->totalMemory / manager->buddyMinBlock : 0;
+    memset(manager->buddyFreeLists, 0, sizeof(manager->buddyFreeLists));
+    manager->buddyOrderMap = 0;
+    for (int order = 0; manager->buddyBlockTable && order <= manager->buddyMaxOrder; order++)
+    {
+        memset(manager->buddyFreeBitmap[order], 0, ((blockCount >> order) / 64 + 1) * sizeof(uint64_t));
+    }
+    if (manager->buddyBlockTable)
+    {
+        memset(manager->buddyBlockTable, 0, (blockCount > 0 ? blockCount : 1) * sizeof(MemorySegment *));
+    }
+
+    manager->tlsfFlBitmap = 0;
+    memset(manager->tlsfSlBitmap, 0, sizeof(manager->tlsfSlBitmap));
+    memset(manager->tlsfFreeLists, 0, sizeof(manager->tlsfFreeLists));
+
+    manager->freeBlockBytes = 0;
+    manager->freeBlockCount = 0;
+    manager->allocatedBlockBytes = 0;
+    manager->wastedBlockBytes = 0;
+}
+
+// Index of the restored segment at address (segments are in address order), or count if there is none
+static size_t findSnapshotSegment(MemorySegment **segments, size_t count, uint64_t address)
+{
+    size_t low = 0;
+    size_t high = count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (segments[mid]->address < address)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low < count && segments[low]->address == address ? low : count;
+}
+
+// Put a restored free segment on the free lists of the strategy
+static void indexSnapshotSegment(MemoryManager *manager, MemorySegment *segment)
+{
+    switch (manager->strategy)
+    {
+    case BUDDY:
+        buddyPushFree(manager, segment, highestBit64((uint64_t)(segment->size / manager->buddyMinBlock)));
+        break;
+    case TLSF:
+        tlsfInsertFree(manager, segment);
+        break;
+    default:
+        indexFreeSegment(manager, segment);
+        break;
+    }
+}
+
+// Rebuild the segment list in address order, then the free lists in their saved order so allocation picks the
+// same segments it would have before the snapshot
+static bool restoreSnapshotSegments(MemoryManager *manager, const SnapshotSegment *records, size_t count, MemorySegment **segments)
+{
+    if (manager->strategy == PAGING)
+    {
+        return count == 0;
+    }
+
+    size_t minBlock = manager->buddyMinBlock;
+    size_t end = manager->strategy == BUDDY ? manager->totalMemory / minBlock * minBlock : manager->totalMemory;
+    size_t address = 0;
+    MemorySegment *tail = NULL;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const SnapshotSegment *record = &records[i];
+        if (record->address != address || record->size == 0 || record->size > end - address ||
+            (record->allocated && record->usedBytes > record->size))
+        {
+            return false;
+        }
+
+        if (manager->strategy == BUDDY)
+        {
+            // Blocks are power-of-two multiples of the smallest block, aligned to their size
+            size_t blocks = record->size / minBlock;
+            if (record->size % minBlock != 0 || (blocks & (blocks - 1)) != 0 || record->address % record->size != 0 ||
+                highestBit64((uint64_t)blocks) > manager->buddyMaxOrder)
             {
-                // Reset line
-                for (int j = 0; j < displayWidth; j++)
-                    visualLine[j] = ' ';
+                return false;
+            }
+        }
 
-                bool hasPageInRow = false;
+        MemorySegment *segment = createFreeSegment(manager, record->address, record->size);
+        if (!segment)
+        {
+            return false;
+        }
+        segment->id = record->id;
+        if (tail)
+            linkSegmentAfter(tail, segment);
+        else
+            manager->segmentList = segment;
+        tail = segment;
+        segments[i] = segment;
+        address += record->size;
 
-                // Check each page in this row
-                for (int col = 0; col < pagesPerRow && (row * pagesPerRow + col) < totalPages; col++)
-                {
-                    size_t pageNum = row * pagesPerRow + col;
+        if (manager->strategy == BUDDY)
+        {
+            manager->buddyBlockTable[segment->address / minBlock] = segment;
+        }
 
-                    // Check if this page belongs to this process
-                    if (manager->pageFrames[pageNum].allocated &&
-                        manager->pageFrames[pageNum].processId == proc->id)
-                    {
-                        visualLine[col] = 'P';
-                        hasPageInRow = true;
-                    }
-                }
+        if (record->allocated)
+        {
+            segment->allocated = true;
+            segment->usedBytes = record->usedBytes;
+            segment->processId = record->processId;
+            memcpy(segment->processName, record->processName, sizeof(segment->processName));
+            segment->processName[sizeof(segment->processName) - 1] = '\0';
+            memcpy(segment->segmentType, record->segmentType, sizeof(segment->segmentType));
+            segment->segmentType[sizeof(segment->segmentType) - 1] = '\0';
+            manager->allocatedBlockBytes += segment->size;
+            manager->wastedBlockBytes += segment->size - segment->usedBytes;
+        }
+    }
 
-                if (hasPageInRow)
-                {
-                    char label[100];
-                    sprintf(label, " Process %s", proc->name);
+    if (address != end)
+    {
+        return false;
+    }
 
-                    // Append process name to the visualization
-                    int nameLen = strlen(label);
-                    for (int j = 0; j < nameLen && j + pagesPerRow + 1 < displayWidth; j++)
-                        visualLine[pagesPerRow + 1 + j] = label[j];
+    // Free lists are pushed at the head, so each saved list is indexed from its last segment back to its first
+    unsigned char *hasPrevFree = (unsigned char *)calloc(count > 0 ? count : 1, 1);
+    size_t *chain = (size_t *)malloc((count > 0 ? count : 1) * sizeof(size_t));
+    bool ok = hasPrevFree && chain;
+    for (size_t i = 0; ok && i < count; i++)
+    {
+        if (records[i].allocated || records[i].nextFree == SNAPSHOT_NO_SEGMENT)
+        {
+            continue;
+        }
+        size_t next = findSnapshotSegment(segments, count, records[i].nextFree);
+        ok = next < count && !records[next].allocated && !hasPrevFree[next];
+        if (ok)
+        {
+            hasPrevFree[next] = 1;
+        }
+    }
 
-                    info(visualLine);
-                }
-            }
+    size_t indexed = 0;
+    size_t freeSegments = 0;
+    for (size_t i = 0; ok && i < count; i++)
+    {
+        if (records[i].allocated)
+        {
+            continue;
+        }
+        freeSegments++;
+        if (hasPrevFree[i])
+        {
+            continue;
+        }
+
+        // Every successor has exactly one predecessor, so a chain from a head cannot loop
+        size_t length = 0;
+        for (size_t j = i; j < count; j = findSnapshotSegment(segments, count, records[j].nextFree))
+        {
+            chain[length++] = j;
+        }
+        while (length > 0)
+        {
+            indexSnapshotSegment(manager, segments[chain[--length]]);
+            indexed++;
         }
-        break;
     }
 
-    case HYBRID:
+    if (!hasPrevFree || !chain)
     {
-        info("Memory Layout (Hybrid):");
-        info("Segmentation area:");
-        info("Each character represents a memory unit");
-        info("Legend: # = Allocated, . = Free");
+        error("Failed to allocate memory for snapshot bookkeeping");
+    }
+    free(hasPrevFree);
+    free(chain);
 
-        // Visualize segmentation area
-        size_t segMemSize = manager->totalMemory / 2; // Assume half for segmentation
-        double scaleFactor = (double)displayWidth / segMemSize;
+    // A free segment missed by every chain sat on a cycle
+    return ok && indexed == freeSegments;
+}
 
-        // Initialize the display
-        for (int i = 0; i < displayWidth; i++)
-            visualLine[i] = ' ';
-        visualLine[displayWidth] = '\0';
+// Restore the frame table and its allocation bitmap, recounting the frame counters
+static bool restoreSnapshotFrames(MemoryManager *manager, const SnapshotFrame *records, size_t count)
+{
+    if (count != (manager->pageFrames ? manager->totalPages : 0))
+    {
+        return false;
+    }
 
-        // Fill in segments
-        MemorySegment *current = manager->segmentList;
-        while (current)
+    size_t hugeFrames = manager->hugePageSize ? manager->hugePageSize / manager->pageSize : 1;
+    manager->freePages = count;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (records[i].huge && manager->hugePageSize == 0)
         {
-            int startPos = (int)(current->address * scaleFactor);
-            int endPos = (int)((current->address + current->size) * scaleFactor);
+            return false;
+        }
 
-            // Ensure we don't overflow the buffer
-            endPos = (endPos >= displayWidth) ? displayWidth - 1 : endPos;
+        Page *frame = &manager->pageFrames[i];
+        frame->processId = records[i].processId;
+        frame->usedBytes = records[i].usedBytes;
+        frame->refCount = records[i].refCount;
+        frame->huge = records[i].huge;
+        setFrameAllocated(manager, i, records[i].allocated);
 
-            char blockChar = current->allocated ? '#' : '.';
+        if (frame->allocated)
+        {
+            manager->freePages--;
+            manager->frameUsedBytes += frame->usedBytes;
+        }
+        if (frame->huge)
+        {
+            // The first frame of a huge page stands for the whole page in the count
+            manager->hugeFrameUsedBytes += frame->usedBytes;
+            manager->hugePagesAllocated += i % hugeFrames == 0;
+        }
+    }
+    return true;
+}
 
-            for (int i = startPos; i <= endPos && i < displayWidth; i++)
-                visualLine[i] = blockChar;
+// Restore one page table entry of a process
+static bool restoreSnapshotEntry(MemoryManager *manager, Process *proc, const SnapshotEntry *record)
+{
+    if (record->allocated && (record->frameNumber >= manager->totalPages || !manager->pageFrames[record->frameNumber].allocated ||
+                              manager->pageFrames[record->frameNumber].huge != record->huge))
+    {
+        return false;
+    }
 
-            current = current->next;
+    Page *entry = pageTableWalk(proc->pageTable, record->vpage, true);
+    if (!entry || entry->processId >= 0)
+    {
+        return false; // Out of range, out of memory, or a duplicate
+    }
+
+    reservePageTableEntry(entry, record->vpage, proc->id, record->usedBytes);
+    if (record->vpage + 1 > proc->pageTable->topPage)
+    {
+        proc->pageTable->topPage = record->vpage + 1;
+    }
+    entry->frameNumber = record->frameNumber;
+    entry->allocated = record->allocated;
+    entry->huge = record->huge;
+    entry->readOnly = record->readOnly;
+    entry->dirty = record->dirty;
+    entry->referenced = record->referenced;
+    return true;
+}
+
+// Restore the process table, each process's page table and segment chain, and the free-slot stack
+static bool restoreSnapshotProcesses(MemoryManager *manager, const SnapshotHeader *header, const SnapshotProcess *records,
+                                     const SnapshotEntry *entries, const SnapshotSegment *segmentRecords, MemorySegment **segments)
+{
+    int capacity = manager->processCapacity;
+    while (capacity < header->processSlots)
+    {
+        capacity = capacity * 2 < manager->maxProcesses ? capacity * 2 : manager->maxProcesses;
+    }
+    if (capacity > manager->processCapacity)
+    {
+        Process *newProcesses = (Process *)realloc(manager->processes, capacity * sizeof(Process));
+        if (newProcesses)
+        {
+            manager->processes = newProcesses;
+        }
+        int *newFreeSlots = (int *)realloc(manager->freeProcessSlots, capacity * sizeof(int));
+        if (newFreeSlots)
+        {
+            manager->freeProcessSlots = newFreeSlots;
+        }
+        if (!newProcesses || !newFreeSlots)
+        {
+            error("Failed to grow the process table");
+            return false;
         }
+        manager->processCapacity = capacity;
+    }
 
-        // Print memory visualization for segmentation
-        info(visualLine);
+    for (int i = 0; i < header->freeProcessSlotCount; i++)
+    {
+        manager->freeProcessSlots[i] = -1;
+    }
+    manager->freeProcessSlotCount = header->freeProcessSlotCount;
 
-        // Visualize paging area
-        info("\nPaging area:");
-        info("Each character represents a page frame");
-        info("Legend: # = Allocated, . = Free");
+    size_t entryIndex = 0;
+    size_t ownedSegments = 0;
+    for (int slot = 0; slot < header->processSlots; slot++)
+    {
+        const SnapshotProcess *record = &records[slot];
+        Process *proc = &manager->processes[slot];
+        manager->processSlots = slot + 1;
+
+        proc->state = PROCESS_FREE;
+        proc->generation = record->generation & PROCESS_GENERATION_MASK;
+        proc->id = record->id;
+        memcpy(proc->name, record->name, sizeof(proc->name));
+        proc->name[sizeof(proc->name) - 1] = '\0';
+        proc->size = record->size;
+        proc->allocStrategy = record->allocStrategy <= TLSF ? (MemoryStrategy)record->allocStrategy : manager->strategy;
+        proc->segments = NULL;
+        proc->segmentCount = 0;
+        proc->pageTable = NULL;
+
+        if (record->freeSlotPosition >= 0)
+        {
+            if (record->state != PROCESS_FREE || record->freeSlotPosition >= manager->freeProcessSlotCount ||
+                manager->freeProcessSlots[record->freeSlotPosition] != -1)
+            {
+                return false;
+            }
+            manager->freeProcessSlots[record->freeSlotPosition] = slot;
+        }
 
-        // Initialize the display
-        int totalPages = manager->totalPages;
-        int pagesPerRow = displayWidth;
+        if (record->state == PROCESS_FREE)
+        {
+            if (record->entryCount > 0)
+            {
+                return false;
+            }
+            continue;
+        }
 
-        int rowCount = (totalPages + pagesPerRow - 1) / pagesPerRow;
+        if (record->state != PROCESS_RUNNING || record->id != (int)((proc->generation << PROCESS_SLOT_BITS) | (unsigned int)slot) ||
+            record->entryCount > header->entryCount - entryIndex || (record->pageCount < 0 && record->entryCount > 0) ||
+            (record->pageCount >= 0 && !manager->pageFrames))
+        {
+            return false;
+        }
+        proc->state = PROCESS_RUNNING;
+        manager->processCount++;
 
-        for (int row = 0; row < rowCount; row++)
+        if (record->pageCount >= 0)
         {
-            // Initialize the line
-            for (int i = 0; i < displayWidth; i++)
-                visualLine[i] = ' ';
+            proc->pageTable = (PageTable *)calloc(1, sizeof(PageTable));
+            if (!proc->pageTable)
+            {
+                error("Failed to allocate memory for page table");
+                return false;
+            }
+            proc->pageTable->processId = proc->id;
+            proc->pageTable->pageCount = record->pageCount;
 
-            // Fill the line with page frames
-            for (int i = 0; i < pagesPerRow && (row * pagesPerRow + i) < totalPages; i++)
+            for (uint64_t e = 0; e < record->entryCount; e++)
             {
-                size_t pageNum = row * pagesPerRow + i;
-                visualLine[i] = manager->pageFrames[pageNum].allocated ? '#' : '.';
+                if (!restoreSnapshotEntry(manager, proc, &entries[entryIndex++]))
+                {
+                    return false;
+                }
             }
+        }
 
-            info(visualLine);
+        // Relink the segment chain in its saved order, stopping at anything that is not this process's
+        uint64_t address = record->firstSegment;
+        MemorySegment *tail = NULL;
+        while (address != SNAPSHOT_NO_SEGMENT)
+        {
+            size_t index = findSnapshotSegment(segments, header->segmentCount, address);
+            if (index == header->segmentCount || !segments[index]->allocated || segments[index]->processId != proc->id ||
+                proc->segmentCount >= record->segmentCount)
+            {
+                return false;
+            }
+
+            MemorySegment *segment = segments[index];
+            if (tail)
+                tail->nextInProcess = segment;
+            else
+                proc->segments = segment;
+            tail = segment;
+            proc->segmentCount++;
+            address = segmentRecords[index].nextInProcess;
         }
+        if (proc->segmentCount != record->segmentCount)
+        {
+            return false;
+        }
+        ownedSegments += (size_t)proc->segmentCount;
+    }
 
-        break;
+    for (int i = 0; i < manager->freeProcessSlotCount; i++)
+    {
+        if (manager->freeProcessSlots[i] < 0)
+        {
+            return false;
+        }
     }
+
+    // Every allocated segment must be on exactly one live process's chain
+    size_t allocatedSegments = 0;
+    for (uint64_t i = 0; i < header->segmentCount; i++)
+    {
+        allocatedSegments += segments[i]->allocated;
     }
+    return entryIndex == header->entryCount && ownedSegments == allocatedSegments;
+}
 
-    // Show fragmentation statistics
-    char fragMsg[150];
-    switch (manager->strategy)
+// Every allocated frame must be mapped by as many entries as its reference count says and be owned by a restored
+// process (or shared after a fork), and a free frame mapped by none. Slab frames are never saved
+static bool snapshotFrameReferencesValid(MemoryManager *manager, const SnapshotEntry *entries, size_t count)
+{
+    if (!manager->pageFrames)
     {
-    case SEGMENTATION:
-        sprintf(fragMsg, "External Fragmentation: %.2f%%", manager->externalFragmentation * 100);
-        break;
-    case PAGING:
-        sprintf(fragMsg, "Internal Fragmentation: %.2f%%", manager->internalFragmentation * 100);
-        break;
-    case HYBRID:
-        sprintf(fragMsg, "External Fragmentation: %.2f%%, Internal Fragmentation: %.2f%%",
-                manager->externalFragmentation * 100,
-                manager->internalFragmentation * 100);
-        break;
+        return true;
     }
-    info(fragMsg);
 
-    char footer[100];
-    sprintf(footer, "===============================================");
-    info(footer);
+    int *references = (int *)calloc(manager->totalPages > 0 ? manager->totalPages : 1, sizeof(int));
+    if (!references)
+    {
+        error("Failed to allocate memory for snapshot bookkeeping");
+        return false;
+    }
+
+    // Entry frame numbers have already been checked against the frame table
+    for (size_t i = 0; i < count; i++)
+    {
+        if (entries[i].allocated)
+        {
+            references[entries[i].frameNumber]++;
+        }
+    }
+
+    bool valid = true;
+    for (size_t i = 0; valid && i < manager->totalPages; i++)
+    {
+        Page *frame = &manager->pageFrames[i];
+        if (!frame->allocated)
+        {
+            valid = references[i] == 0;
+            continue;
+        }
+        valid = frame->refCount >= 1 && frame->refCount == references[i] &&
+                (frame->processId == SHARED_PROCESS_ID || getProcess(manager, frame->processId));
+    }
+    free(references);
+    return valid;
+}
+
+// Put page table entries back on the replacement lists in their saved order
+static bool restoreSnapshotResidency(MemoryManager *manager, const SnapshotResidency *records, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const SnapshotResidency *record = &records[i];
+        Process *proc = getProcess(manager, record->processId);
+        Page *entry = proc ? pageTableLookup(proc->pageTable, record->vpage) : NULL;
+        if (!entry || entry->residency != RESIDENCY_NONE || record->list <= RESIDENCY_NONE || record->list >= RESIDENCY_LIST_COUNT)
+        {
+            return false;
+        }
+
+        // T1 and T2 hold resident pages, the ARC ghost lists evicted ones
+        bool resident = record->list == RESIDENCY_T1 || record->list == RESIDENCY_T2;
+        if (entry->allocated != resident)
+        {
+            return false;
+        }
+        residencyPush(manager, entry, (ResidencyList)record->list);
+    }
+    return true;
+}
+
+// Create a manager from a snapshot file written by saveMemoryManager. The file is mapped and its records are
+// read in place
+MemoryManager *loadMemoryManager(const char *path)
+{
+    MappedFile *mapped = map_file(path);
+    if (!mapped)
+    {
+        return NULL;
+    }
+
+    const char *data = (const char *)mapped_file_data(mapped);
+    const SnapshotHeader *header = (const SnapshotHeader *)data;
+    if (!snapshotHeaderValid(header, mapped_file_size(mapped), path))
+    {
+        unmap_file(mapped);
+        return NULL;
+    }
+
+    MemoryManager *manager = createMemoryManager((MemoryStrategy)header->strategy, header->totalMemory, header->pageSize,
+                                                 header->maxProcesses, (PlacementPolicy)header->placement);
+    MemorySegment **segments = (MemorySegment **)malloc((header->segmentCount > 0 ? header->segmentCount : 1) * sizeof(MemorySegment *));
+    if (!manager || !segments)
+    {
+        error("Failed to allocate memory for the restored memory manager");
+        free(segments);
+        destroyMemoryManager(manager);
+        unmap_file(mapped);
+        return NULL;
+    }
+
+    manager->hugePageSize = header->hugePageSize;
+    manager->demandPaging = (header->flags & SNAPSHOT_DEMAND_PAGING) != 0;
+    manager->compactOnFailure = (header->flags & SNAPSHOT_COMPACT_ON_FAILURE) != 0;
+    manager->replacement = (ReplacementPolicy)header->replacement;
+    clearSegmentLayout(manager);
+
+    const SnapshotSegment *segmentRecords = (const SnapshotSegment *)(data + header->segmentOffset);
+    bool ok = restoreSnapshotSegments(manager, segmentRecords, header->segmentCount, segments) &&
+              restoreSnapshotFrames(manager, (const SnapshotFrame *)(data + header->frameOffset), header->frameCount) &&
+              restoreSnapshotProcesses(manager, header, (const SnapshotProcess *)(data + header->processOffset),
+                                       (const SnapshotEntry *)(data + header->entryOffset), segmentRecords, segments) &&
+              snapshotFrameReferencesValid(manager, (const SnapshotEntry *)(data + header->entryOffset), header->entryCount) &&
+              restoreSnapshotResidency(manager, (const SnapshotResidency *)(data + header->residencyOffset), header->residencyCount);
+
+    if (ok)
+    {
+        size_t nextFit = findSnapshotSegment(segments, header->segmentCount, header->nextFitAddress);
+        size_t compact = findSnapshotSegment(segments, header->segmentCount, header->compactAddress);
+        manager->nextFitCursor = nextFit < header->segmentCount ? segments[nextFit] : NULL;
+        manager->compactCursor = compact < header->segmentCount ? segments[compact] : NULL;
+
+        manager->freeMemory = header->freeMemory;
+        manager->usedMemory = header->usedMemory;
+        manager->arcTarget = header->arcTarget;
+        manager->externalFragmentation = header->externalFragmentation;
+        manager->internalFragmentation = header->internalFragmentation;
+        manager->pagingStats = header->pagingStats;
+        manager->cowStats = header->cowStats;
+    }
+
+    // The header lives in the mapping
+    unsigned long long segmentCount = (unsigned long long)header->segmentCount;
+    unsigned long long frameCount = (unsigned long long)header->frameCount;
+    free(segments);
+    unmap_file(mapped);
+
+    char logMsg[400];
+    if (!ok)
+    {
+        sprintf(logMsg, "Snapshot %.256s is corrupt", path);
+        error(logMsg);
+        destroyMemoryManager(manager);
+        return NULL;
+    }
+
+    sprintf(logMsg, "Loaded snapshot %.256s: %s, %llu segments, %llu frames, %d processes",
+            path, memoryStrategyName(manager->strategy), segmentCount, frameCount, manager->processCount);
+    info(logMsg);
+
+    return manager;
 }
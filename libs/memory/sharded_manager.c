@@ -0,0 +1,383 @@
+#include "../../include/memory/sharded_manager.h"
+#include "../../include/memory/workload.h"
+#include "../../include/platform/thread.h"
+#include "../../include/log/logger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// Arguments and counters of one benchmark thread
+typedef struct
+{
+    ShardedMemoryManager *sharded;
+    uint64_t seed;
+    size_t operations;
+    size_t failed;
+} BenchWorker;
+
+// Take a shard's lock, counting acquisitions that had to wait for another thread
+static void lockShard(MemoryShard *shard)
+{
+    bool contended = !try_lock_mutex(shard->lock);
+    if (contended)
+    {
+        lock_mutex(shard->lock);
+    }
+
+    shard->acquisitions++;
+    if (contended)
+    {
+        shard->contended++;
+    }
+}
+
+static void unlockShard(MemoryShard *shard)
+{
+    unlock_mutex(shard->lock);
+}
+
+// Threads are numbered on their first sharded call, so consecutive threads get different home shards
+static volatile long threadsSeen = 0;
+static PLATFORM_THREAD_LOCAL long threadOrdinal = 0;
+
+// Shard a thread allocates from first
+static int homeShard(ShardedMemoryManager *sharded)
+{
+    if (threadOrdinal == 0)
+    {
+        threadOrdinal = atomic_increment(&threadsSeen);
+    }
+    return (int)((threadOrdinal - 1) % sharded->shardCount);
+}
+
+// Shard owning a sharded process id, or NULL (with an error) for ids no shard issued
+static MemoryShard *processShard(ShardedMemoryManager *sharded, int64_t processId)
+{
+    if (processId < 0 || SHARDED_PROCESS_SHARD(processId) >= sharded->shardCount)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Invalid sharded process ID: %lld", (long long)processId);
+        error(errMsg);
+        return NULL;
+    }
+
+    return &sharded->shards[SHARDED_PROCESS_SHARD(processId)];
+}
+
+// Split totalMemory into shardCount equally sized, independently locked managers
+ShardedMemoryManager *createShardedMemoryManager(MemoryStrategy strategy, size_t totalMemory, size_t pageSize,
+                                                 int maxProcesses, PlacementPolicy placement, int shardCount)
+{
+    if (shardCount <= 0 || shardCount > SHARDED_MAX_SHARDS)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Cannot create sharded manager: shard count must be between 1 and %d", SHARDED_MAX_SHARDS);
+        error(errMsg);
+        return NULL;
+    }
+
+    // Paged shards hold whole frames
+    size_t shardMemory = totalMemory / shardCount;
+    if (pageSize > 0)
+    {
+        shardMemory -= shardMemory % pageSize;
+    }
+
+    ShardedMemoryManager *sharded = (ShardedMemoryManager *)malloc(sizeof(ShardedMemoryManager));
+    MemoryShard *shards = (MemoryShard *)calloc(shardCount, sizeof(MemoryShard));
+    if (!sharded || !shards)
+    {
+        error("Failed to allocate memory for sharded manager");
+        free(sharded);
+        free(shards);
+        return NULL;
+    }
+
+    sharded->strategy = strategy;
+    sharded->totalMemory = shardMemory * shardCount;
+    sharded->shardCount = shardCount;
+    sharded->shards = shards;
+
+    for (int i = 0; i < shardCount; i++)
+    {
+        shards[i].baseAddress = shardMemory * i;
+        shards[i].manager = createMemoryManager(strategy, shardMemory, pageSize, maxProcesses, placement);
+        shards[i].lock = create_mutex(NULL);
+        if (!shards[i].manager || !shards[i].lock)
+        {
+            error("Failed to create memory shard");
+            destroyShardedMemoryManager(sharded);
+            return NULL;
+        }
+    }
+
+    char logMsg[150];
+    sprintf(logMsg, "Sharded %s manager created: %d shards of %zu bytes", memoryStrategyName(strategy), shardCount, shardMemory);
+    info(logMsg);
+
+    return sharded;
+}
+
+void destroyShardedMemoryManager(ShardedMemoryManager *sharded)
+{
+    if (!sharded)
+    {
+        return;
+    }
+
+    for (int i = 0; i < sharded->shardCount; i++)
+    {
+        if (sharded->shards[i].manager)
+        {
+            destroyMemoryManager(sharded->shards[i].manager);
+        }
+        if (sharded->shards[i].lock)
+        {
+            close_mutex(sharded->shards[i].lock);
+        }
+    }
+
+    free(sharded->shards);
+    free(sharded);
+}
+
+// Create the process on the calling thread's home shard, spilling over to the others when it is full
+int64_t shardedCreateProcess(ShardedMemoryManager *sharded, const char *name, size_t size)
+{
+    int home = homeShard(sharded);
+
+    for (int i = 0; i < sharded->shardCount; i++)
+    {
+        int index = (home + i) % sharded->shardCount;
+        MemoryShard *shard = &sharded->shards[index];
+
+        lockShard(shard);
+        int processId = createProcess(shard->manager, name, size);
+        unlockShard(shard);
+
+        if (processId >= 0)
+        {
+            return SHARDED_PROCESS_ID(index, processId);
+        }
+    }
+
+    return -1;
+}
+
+bool shardedTerminateProcess(ShardedMemoryManager *sharded, int64_t processId)
+{
+    MemoryShard *shard = processShard(sharded, processId);
+    if (!shard)
+    {
+        return false;
+    }
+
+    lockShard(shard);
+    bool success = terminateProcess(shard->manager, SHARDED_PROCESS_LOCAL(processId));
+    unlockShard(shard);
+
+    return success;
+}
+
+// A process grows within its own shard, since its memory cannot span shards
+bool shardedAllocateSegment(ShardedMemoryManager *sharded, int64_t processId, const char *segmentType, size_t size)
+{
+    MemoryShard *shard = processShard(sharded, processId);
+    if (!shard)
+    {
+        return false;
+    }
+
+    lockShard(shard);
+    bool success = allocateSegment(shard->manager, SHARDED_PROCESS_LOCAL(processId), segmentType, size);
+    unlockShard(shard);
+
+    return success;
+}
+
+bool shardedAllocatePages(ShardedMemoryManager *sharded, int64_t processId, size_t size)
+{
+    MemoryShard *shard = processShard(sharded, processId);
+    if (!shard)
+    {
+        return false;
+    }
+
+    // allocatePages reads the process's top page, so it has to happen under the lock
+    lockShard(shard);
+    bool success = allocatePages(shard->manager, SHARDED_PROCESS_LOCAL(processId), size);
+    unlockShard(shard);
+
+    return success;
+}
+
+bool shardedAllocatePagesAt(ShardedMemoryManager *sharded, int64_t processId, size_t virtualAddress, size_t size)
+{
+    MemoryShard *shard = processShard(sharded, processId);
+    if (!shard)
+    {
+        return false;
+    }
+
+    lockShard(shard);
+    bool success = allocatePagesAt(shard->manager, SHARDED_PROCESS_LOCAL(processId), virtualAddress, size);
+    unlockShard(shard);
+
+    return success;
+}
+
+// Print each shard's usage and lock contention, then the totals
+void printShardedStats(ShardedMemoryManager *sharded)
+{
+    char logMsg[200];
+    size_t usedMemory = 0;
+    size_t acquisitions = 0;
+    size_t contended = 0;
+    int processCount = 0;
+
+    info("======== Sharded Memory Manager ========");
+    for (int i = 0; i < sharded->shardCount; i++)
+    {
+        MemoryShard *shard = &sharded->shards[i];
+
+        lockShard(shard);
+        sprintf(logMsg, "Shard %d @ %zu: %d processes, %zu/%zu bytes used, %zu lock acquisitions (%.2f%% contended)",
+                i, shard->baseAddress, shard->manager->processCount, shard->manager->usedMemory, shard->manager->totalMemory,
+                shard->acquisitions, shard->acquisitions ? 100.0 * shard->contended / shard->acquisitions : 0.0);
+        usedMemory += shard->manager->usedMemory;
+        processCount += shard->manager->processCount;
+        acquisitions += shard->acquisitions;
+        contended += shard->contended;
+        unlockShard(shard);
+
+        info(logMsg);
+    }
+
+    sprintf(logMsg, "Total: %d processes, %zu/%zu bytes used, %.2f%% of lock acquisitions contended",
+            processCount, usedMemory, sharded->totalMemory, acquisitions ? 100.0 * contended / acquisitions : 0.0);
+    info(logMsg);
+}
+
+// Churn through processes: create, grow a live one, or terminate a live one
+static void benchWorkerRun(void *arg)
+{
+    BenchWorker *worker = (BenchWorker *)arg;
+    ShardedMemoryManager *sharded = worker->sharded;
+
+    WorkloadRandom random;
+    seedWorkloadRandom(&random, worker->seed);
+    Distribution size = {DIST_EXPONENTIAL, 4096.0, 0.0, 0.0};
+
+    int64_t live[SHARDED_BENCH_LIVE_PROCESSES];
+    int liveCount = 0;
+
+    for (size_t op = 0; op < worker->operations; op++)
+    {
+        double choice = workloadUniform(&random);
+        size_t bytes = (size_t)sampleDistribution(&random, &size) + 1;
+        bool success;
+
+        if (liveCount == SHARDED_BENCH_LIVE_PROCESSES || (liveCount > 0 && choice < 0.4))
+        {
+            int victim = (int)(workloadUniform(&random) * liveCount);
+            success = shardedTerminateProcess(sharded, live[victim]);
+            live[victim] = live[--liveCount];
+        }
+        else if (liveCount > 0 && choice < 0.55)
+        {
+            int64_t processId = live[(int)(workloadUniform(&random) * liveCount)];
+            if (sharded->strategy == PAGING)
+            {
+                success = shardedAllocatePages(sharded, processId, bytes);
+            }
+            else
+            {
+                success = shardedAllocateSegment(sharded, processId, "heap", bytes);
+            }
+        }
+        else
+        {
+            int64_t processId = shardedCreateProcess(sharded, "bench", bytes);
+            success = processId >= 0;
+            if (success)
+            {
+                live[liveCount++] = processId;
+            }
+        }
+
+        if (!success)
+        {
+            worker->failed++;
+        }
+    }
+
+    while (liveCount > 0)
+    {
+        shardedTerminateProcess(sharded, live[--liveCount]);
+    }
+}
+
+ShardedBenchmarkResult runShardedBenchmark(MemoryStrategy strategy, size_t totalMemory, size_t pageSize, PlacementPolicy placement,
+                                           int threads, int shards, size_t opsPerThread, uint64_t seed)
+{
+    ShardedBenchmarkResult result;
+    memset(&result, 0, sizeof(result));
+    result.threads = threads;
+    result.shards = shards;
+
+    // Logging would serialise the threads on the terminal, so the shards run silently
+    int savedOutput = log_output;
+    log_output = LOG_TO_NONE;
+
+    ShardedMemoryManager *sharded = createShardedMemoryManager(strategy, totalMemory, pageSize,
+                                                               threads * SHARDED_BENCH_LIVE_PROCESSES, placement, shards);
+    BenchWorker *workers = (BenchWorker *)calloc(threads, sizeof(BenchWorker));
+    ThreadHandle **handles = (ThreadHandle **)calloc(threads, sizeof(ThreadHandle *));
+    if (!sharded || !workers || !handles)
+    {
+        log_output = savedOutput;
+        error("Failed to set up sharded benchmark");
+        destroyShardedMemoryManager(sharded);
+        free(workers);
+        free(handles);
+        return result;
+    }
+
+    uint64_t start = platform_monotonic_ns();
+    for (int i = 0; i < threads; i++)
+    {
+        workers[i].sharded = sharded;
+        workers[i].seed = seed + (uint64_t)i;
+        workers[i].operations = opsPerThread;
+        handles[i] = create_thread(benchWorkerRun, &workers[i]);
+    }
+
+    for (int i = 0; i < threads; i++)
+    {
+        if (handles[i])
+        {
+            join_thread(handles[i]);
+            result.operations += workers[i].operations;
+            result.failed += workers[i].failed;
+        }
+    }
+    result.elapsedSeconds = (platform_monotonic_ns() - start) / 1e9;
+
+    size_t acquisitions = 0;
+    size_t contended = 0;
+    for (int i = 0; i < shards; i++)
+    {
+        acquisitions += sharded->shards[i].acquisitions;
+        contended += sharded->shards[i].contended;
+    }
+
+    result.opsPerSecond = result.elapsedSeconds > 0.0 ? result.operations / result.elapsedSeconds : 0.0;
+    result.contention = acquisitions ? (double)contended / acquisitions : 0.0;
+
+    destroyShardedMemoryManager(sharded);
+    free(workers);
+    free(handles);
+    log_output = savedOutput;
+
+    return result;
+}
@@ -0,0 +1,316 @@
+#include "../../include/memory/slab_cache.h"
+#include "../../include/log/logger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// Push a slab onto the head of one of the cache's lists
+static void pushSlab(Slab **list, Slab *slab)
+{
+    slab->prev = NULL;
+    slab->next = *list;
+    if (*list)
+    {
+        (*list)->prev = slab;
+    }
+    *list = slab;
+}
+
+// Unlink a slab from one of the cache's lists
+static void unlinkSlab(Slab **list, Slab *slab)
+{
+    if (slab->prev)
+    {
+        slab->prev->next = slab->next;
+    }
+    else
+    {
+        *list = slab->next;
+    }
+
+    if (slab->next)
+    {
+        slab->next->prev = slab->prev;
+    }
+
+    slab->next = NULL;
+    slab->prev = NULL;
+}
+
+// Take a free page frame from the manager and carve it into object slots
+static Slab *createSlab(ObjectCache *cache)
+{
+    MemoryManager *manager = cache->manager;
+
+    int frameNumber = findFreePages(manager, 1);
+    if (frameNumber < 0)
+    {
+        return NULL;
+    }
+
+    Slab *slab = (Slab *)malloc(sizeof(Slab));
+    int *nextFreeSlot = (int *)malloc(cache->objectsPerSlab * sizeof(int));
+    if (!slab || !nextFreeSlot)
+    {
+        error("Failed to allocate memory for slab");
+        free(slab);
+        free(nextFreeSlot);
+        return NULL;
+    }
+
+    slab->nextFreeSlot = nextFreeSlot;
+    slab->cache = cache;
+    slab->frameNumber = frameNumber;
+    slab->freeCount = cache->objectsPerSlab;
+    slab->freeHead = 0;
+    for (int i = 0; i < cache->objectsPerSlab; i++)
+    {
+        slab->nextFreeSlot[i] = (i + 1 < cache->objectsPerSlab) ? i + 1 : -1;
+    }
+    slab->next = NULL;
+    slab->prev = NULL;
+
+    // Hand the frame over to the cache
+    Page *frame = &manager->pageFrames[frameNumber];
+    setFrameAllocated(manager, frameNumber, true);
+    frame->processId = SLAB_PROCESS_ID;
+    frame->usedBytes = 0;
+    frame->slab = slab;
+
+    manager->freePages--;
+    manager->freeMemory -= manager->pageSize;
+
+    cache->slabCount++;
+    cache->stats.slabsCreated++;
+
+    return slab;
+}
+
+// Give a slab's page frame back to the manager
+static void releaseSlab(ObjectCache *cache, Slab *slab)
+{
+    MemoryManager *manager = cache->manager;
+
+    Page *frame = &manager->pageFrames[slab->frameNumber];
+    setFrameAllocated(manager, slab->frameNumber, false);
+    manager->frameUsedBytes -= frame->usedBytes;
+    frame->processId = -1;
+    frame->usedBytes = 0;
+    frame->slab = NULL;
+
+    manager->freePages++;
+    manager->freeMemory += manager->pageSize;
+
+    cache->slabCount--;
+    cache->stats.slabsReleased++;
+
+    free(slab->nextFreeSlot);
+    free(slab);
+}
+
+// Create a cache of objectSize-byte objects backed by the manager's page frames
+ObjectCache *createCache(MemoryManager *manager, size_t objectSize)
+{
+    if (!manager || !manager->pageFrames)
+    {
+        error("Cannot create object cache: memory manager has no page frames");
+        return NULL;
+    }
+
+    size_t slotSize = (objectSize + SLAB_OBJECT_ALIGN - 1) / SLAB_OBJECT_ALIGN * SLAB_OBJECT_ALIGN;
+    if (objectSize == 0 || slotSize > manager->pageSize)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Cannot create object cache: object size %zu must be between 1 and the page size", objectSize);
+        error(errMsg);
+        return NULL;
+    }
+
+    ObjectCache *cache = (ObjectCache *)malloc(sizeof(ObjectCache));
+    if (!cache)
+    {
+        error("Failed to allocate memory for object cache");
+        return NULL;
+    }
+
+    cache->manager = manager;
+    cache->objectSize = objectSize;
+    cache->slotSize = slotSize;
+    cache->objectsPerSlab = (int)(manager->pageSize / slotSize);
+    cache->partialSlabs = NULL;
+    cache->fullSlabs = NULL;
+    cache->emptySlabs = NULL;
+    cache->slabCount = 0;
+    memset(&cache->stats, 0, sizeof(cache->stats));
+
+    char logMsg[100];
+    sprintf(logMsg, "Created object cache: %zu-byte objects, %d per slab", objectSize, cache->objectsPerSlab);
+    info(logMsg);
+
+    return cache;
+}
+
+// Destroy a cache, returning every slab's frame to the manager
+void destroyCache(ObjectCache *cache)
+{
+    if (!cache)
+        return;
+
+    Slab **lists[] = {&cache->partialSlabs, &cache->fullSlabs, &cache->emptySlabs};
+    for (int i = 0; i < 3; i++)
+    {
+        while (*lists[i])
+        {
+            Slab *slab = *lists[i];
+            unlinkSlab(lists[i], slab);
+
+            // Objects still live in the slab are dropped with it
+            int liveObjects = cache->objectsPerSlab - slab->freeCount;
+            cache->manager->usedMemory -= liveObjects * cache->objectSize;
+            releaseSlab(cache, slab);
+        }
+    }
+
+    free(cache);
+}
+
+// Allocate one object, preferring partially used slabs over empty ones
+bool cacheAlloc(ObjectCache *cache, size_t *address)
+{
+    Slab *slab = cache->partialSlabs;
+    Slab **source = &cache->partialSlabs;
+
+    if (!slab)
+    {
+        slab = cache->emptySlabs;
+        source = &cache->emptySlabs;
+    }
+
+    if (!slab)
+    {
+        slab = createSlab(cache);
+        source = NULL;
+        if (!slab)
+        {
+            cache->stats.failedAllocs++;
+            error("Object cache allocation failed: no free page frame for a new slab");
+            return false;
+        }
+    }
+
+    // Pop a slot off the slab's free chain
+    int slot = slab->freeHead;
+    slab->freeHead = slab->nextFreeSlot[slot];
+    slab->nextFreeSlot[slot] = SLAB_SLOT_IN_USE;
+    slab->freeCount--;
+
+    // Move the slab to the list matching its new occupancy
+    if (source)
+    {
+        unlinkSlab(source, slab);
+    }
+    pushSlab(slab->freeCount == 0 ? &cache->fullSlabs : &cache->partialSlabs, slab);
+
+    MemoryManager *manager = cache->manager;
+    manager->pageFrames[slab->frameNumber].usedBytes += cache->objectSize;
+    manager->frameUsedBytes += cache->objectSize;
+    manager->usedMemory += cache->objectSize;
+
+    cache->stats.activeObjects++;
+    cache->stats.totalAllocs++;
+
+    *address = slab->frameNumber * manager->pageSize + (size_t)slot * cache->slotSize;
+    return true;
+}
+
+// Free an object previously returned by cacheAlloc
+bool cacheFree(ObjectCache *cache, size_t address)
+{
+    MemoryManager *manager = cache->manager;
+    size_t frameNumber = address / manager->pageSize;
+    size_t offset = address % manager->pageSize;
+
+    Slab *slab = frameNumber < manager->totalPages ? manager->pageFrames[frameNumber].slab : NULL;
+    int slot = (int)(offset / cache->slotSize);
+
+    if (!slab || slab->cache != cache || offset % cache->slotSize != 0 || slot >= cache->objectsPerSlab ||
+        slab->nextFreeSlot[slot] != SLAB_SLOT_IN_USE)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Invalid object cache free at address %zu", address);
+        error(errMsg);
+        return false;
+    }
+
+    bool wasFull = slab->freeCount == 0;
+
+    // Push the slot back onto the slab's free chain
+    slab->nextFreeSlot[slot] = slab->freeHead;
+    slab->freeHead = slot;
+    slab->freeCount++;
+
+    unlinkSlab(wasFull ? &cache->fullSlabs : &cache->partialSlabs, slab);
+    pushSlab(slab->freeCount == cache->objectsPerSlab ? &cache->emptySlabs : &cache->partialSlabs, slab);
+
+    manager->pageFrames[frameNumber].usedBytes -= cache->objectSize;
+    manager->frameUsedBytes -= cache->objectSize;
+    manager->usedMemory -= cache->objectSize;
+
+    cache->stats.activeObjects--;
+    cache->stats.totalFrees++;
+
+    return true;
+}
+
+// Return the frames of all empty slabs to the page frame table
+size_t cacheShrink(ObjectCache *cache)
+{
+    size_t released = 0;
+
+    while (cache->emptySlabs)
+    {
+        Slab *slab = cache->emptySlabs;
+        unlinkSlab(&cache->emptySlabs, slab);
+        releaseSlab(cache, slab);
+        released++;
+    }
+
+    return released;
+}
+
+// Print cache occupancy and statistics
+void printCacheStats(ObjectCache *cache)
+{
+    if (!cache)
+        return;
+
+    int partial = 0, full = 0, empty = 0;
+    for (Slab *slab = cache->partialSlabs; slab; slab = slab->next)
+        partial++;
+    for (Slab *slab = cache->fullSlabs; slab; slab = slab->next)
+        full++;
+    for (Slab *slab = cache->emptySlabs; slab; slab = slab->next)
+        empty++;
+
+    size_t capacity = (size_t)cache->slabCount * cache->objectsPerSlab;
+    size_t slabBytes = (size_t)cache->slabCount * cache->manager->pageSize;
+
+    char logMsg[200];
+    sprintf(logMsg, "======== Object Cache (%zu-byte objects) ========", cache->objectSize);
+    info(logMsg);
+
+    sprintf(logMsg, "Slabs: %d (partial: %d, full: %d, empty: %d), %d objects per slab",
+            cache->slabCount, partial, full, empty, cache->objectsPerSlab);
+    info(logMsg);
+
+    sprintf(logMsg, "Objects: %zu active of %zu slots (%.1f%% utilisation), %zu bytes wasted",
+            cache->stats.activeObjects, capacity,
+            capacity > 0 ? (double)cache->stats.activeObjects / capacity * 100 : 0.0,
+            slabBytes - cache->stats.activeObjects * cache->objectSize);
+    info(logMsg);
+
+    sprintf(logMsg, "Allocs: %zu, Frees: %zu, Failed: %zu, Slabs created: %zu, Slabs released: %zu",
+            cache->stats.totalAllocs, cache->stats.totalFrees, cache->stats.failedAllocs,
+            cache->stats.slabsCreated, cache->stats.slabsReleased);
+    info(logMsg);
+}
@@ -0,0 +1,372 @@
+#include "../../include/memory/swap.h"
+#include "../../include/platform/sync.h"
+#include "../../include/log/logger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// Identifies the page a swap slot was written for, stored at the start of the slot
+typedef struct
+{
+    int processId;
+    size_t vpage;
+} SwapStamp;
+
+static bool slotUsed(SwapDevice *swap, size_t slot)
+{
+    return (swap->slotBitmap[slot / 64] >> (slot % 64)) & 1;
+}
+
+static void setSlotUsed(SwapDevice *swap, size_t slot, bool used)
+{
+    if (used)
+    {
+        swap->slotBitmap[slot / 64] |= (uint64_t)1 << (slot % 64);
+        swap->freeSlots--;
+    }
+    else
+    {
+        swap->slotBitmap[slot / 64] &= ~((uint64_t)1 << (slot % 64));
+        swap->freeSlots++;
+    }
+}
+
+static void recordLatency(SwapLatency *latency, uint64_t elapsedNs)
+{
+    int bucket = 0;
+    while (bucket < SWAP_LATENCY_BUCKETS - 1 && (elapsedNs >> (bucket + 1)) != 0)
+    {
+        bucket++;
+    }
+
+    latency->buckets[bucket]++;
+    latency->operations++;
+    latency->totalNs += elapsedNs;
+    if (elapsedNs > latency->maxNs)
+    {
+        latency->maxNs = elapsedNs;
+    }
+}
+
+// Create a swap area of slotCount pages, backed by a file at path or simulated when path is NULL
+SwapDevice *createSwapDevice(const char *path, size_t pageSize, size_t slotCount, size_t batchPages, int readahead)
+{
+    if (pageSize == 0 || slotCount == 0 || batchPages == 0 || readahead < 0 || readahead > SWAP_MAX_READAHEAD)
+    {
+        char errMsg[150];
+        sprintf(errMsg, "Cannot create swap device: needs a page size, slots, a batch size and readahead of at most %d pages",
+                SWAP_MAX_READAHEAD);
+        error(errMsg);
+        return NULL;
+    }
+
+    size_t bufferPages = batchPages > (size_t)readahead + 1 ? batchPages : (size_t)readahead + 1;
+    SwapDevice *swap = (SwapDevice *)malloc(sizeof(SwapDevice));
+    uint64_t *slotBitmap = (uint64_t *)calloc(slotCount / 64 + 1, sizeof(uint64_t));
+    Page **pending = (Page **)malloc(batchPages * sizeof(Page *));
+    unsigned char *buffer = (unsigned char *)calloc(bufferPages, pageSize);
+    FILE *file = path ? fopen(path, "w+b") : NULL;
+    if (!swap || !slotBitmap || !pending || !buffer || (path && !file))
+    {
+        error(path && !file ? "Cannot open swap file" : "Failed to allocate memory for swap device");
+        free(swap);
+        free(slotBitmap);
+        free(pending);
+        free(buffer);
+        if (file)
+        {
+            fclose(file);
+        }
+        return NULL;
+    }
+
+    swap->file = file;
+    swap->pageSize = pageSize;
+    swap->slotCount = slotCount;
+    swap->freeSlots = slotCount;
+    swap->slotBitmap = slotBitmap;
+    swap->slotCursor = 0;
+    swap->batchPages = batchPages;
+    swap->pending = pending;
+    swap->pendingCount = 0;
+    swap->readahead = readahead;
+    swap->seekNs = SWAP_SIMULATED_SEEK_NS;
+    swap->pageNs = SWAP_SIMULATED_PAGE_NS;
+    swap->buffer = buffer;
+    memset(&swap->stats, 0, sizeof(swap->stats));
+
+    char logMsg[200];
+    sprintf(logMsg, "Created swap device: %zu slots of %zu bytes (%s), %zu-page writeback batches, %d-page readahead",
+            slotCount, pageSize, path ? path : "simulated", batchPages, readahead);
+    info(logMsg);
+
+    return swap;
+}
+
+// Pending writeback is dropped; detach the device from its manager first
+void destroySwapDevice(SwapDevice *swap)
+{
+    if (!swap)
+        return;
+
+    if (swap->file)
+    {
+        fclose(swap->file);
+    }
+    free(swap->slotBitmap);
+    free(swap->pending);
+    free(swap->buffer);
+    free(swap);
+}
+
+// Move count pages between the staging buffer and the slots starting at slot, timing the operation
+static bool swapTransfer(SwapDevice *swap, size_t slot, size_t count, bool write)
+{
+    uint64_t elapsed;
+    bool success = true;
+
+    if (swap->file)
+    {
+        uint64_t start = platform_monotonic_ns();
+        success = fseek(swap->file, (long)(slot * swap->pageSize), SEEK_SET) == 0 &&
+                  (write ? fwrite(swap->buffer, swap->pageSize, count, swap->file) == count && fflush(swap->file) == 0
+                         : fread(swap->buffer, swap->pageSize, count, swap->file) == count);
+        elapsed = platform_monotonic_ns() - start;
+    }
+    else
+    {
+        elapsed = swap->seekNs + swap->pageNs * count;
+    }
+
+    recordLatency(write ? &swap->stats.outLatency : &swap->stats.inLatency, elapsed);
+    if (!success)
+    {
+        swap->stats.ioErrors++;
+    }
+    return success;
+}
+
+// Start of count adjacent free slots, searching on from the cursor; -1 when there is no such run
+static long findFreeSlots(SwapDevice *swap, size_t count)
+{
+    size_t run = 0;
+    for (size_t i = 0; i < swap->slotCount; i++)
+    {
+        size_t slot = (swap->slotCursor + i) % swap->slotCount;
+        if (slot == 0)
+        {
+            run = 0; // Runs do not wrap around the end of the device
+        }
+
+        run = slotUsed(swap, slot) ? 0 : run + 1;
+        if (run == count)
+        {
+            return (long)(slot + 1 - count);
+        }
+    }
+    return -1;
+}
+
+// Write entries (adjacent virtual pages of one process) to the adjacent slots starting at slot
+static void writeRun(SwapDevice *swap, Page **entries, size_t count, size_t slot)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        SwapStamp stamp = {entries[i]->processId, entries[i]->id};
+        memcpy(swap->buffer + i * swap->pageSize, &stamp, sizeof(stamp));
+        setSlotUsed(swap, slot + i, true);
+        entries[i]->swapSlot = (long)(slot + i);
+    }
+
+    swapTransfer(swap, slot, count, true);
+    swap->slotCursor = (slot + count) % swap->slotCount;
+    swap->stats.pagesOut += count;
+}
+
+// Writeback order: by process, then by virtual page
+static int comparePending(const void *a, const void *b)
+{
+    const Page *x = *(const Page *const *)a;
+    const Page *y = *(const Page *const *)b;
+    if (x->processId != y->processId)
+        return x->processId < y->processId ? -1 : 1;
+    return x->id < y->id ? -1 : (x->id > y->id ? 1 : 0);
+}
+
+// Write the writeback buffer out: each run of adjacent virtual pages of a process goes to adjacent slots
+// in one operation, split into shorter runs only when free slots are fragmented
+void flushSwap(SwapDevice *swap)
+{
+    if (swap->pendingCount == 0)
+    {
+        return;
+    }
+
+    qsort(swap->pending, swap->pendingCount, sizeof(Page *), comparePending);
+    swap->stats.writeBatches++;
+
+    size_t i = 0;
+    while (i < swap->pendingCount)
+    {
+        size_t length = 1;
+        while (i + length < swap->pendingCount && swap->pending[i + length]->processId == swap->pending[i]->processId &&
+               swap->pending[i + length]->id == swap->pending[i + length - 1]->id + 1)
+        {
+            length++;
+        }
+
+        long slot = -1;
+        while (length > 0 && (slot = findFreeSlots(swap, length)) < 0)
+        {
+            length /= 2;
+        }
+
+        if (slot < 0)
+        {
+            // Swap is full: the rest of the buffer is lost, and faults will find the pages zeroed
+            for (; i < swap->pendingCount; i++)
+            {
+                swap->pending[i]->swapSlot = SWAP_NO_SLOT;
+                swap->stats.discarded++;
+            }
+            break;
+        }
+
+        writeRun(swap, &swap->pending[i], length, (size_t)slot);
+        i += length;
+    }
+
+    swap->pendingCount = 0;
+}
+
+// Buffer a dirty evicted page for writeback, flushing the buffer once it holds a full batch
+void swapQueueWriteback(SwapDevice *swap, Page *entry)
+{
+    swapReleaseSlot(swap, entry); // Any copy already on the device is stale
+
+    entry->swapSlot = SWAP_SLOT_PENDING;
+    swap->pending[swap->pendingCount++] = entry;
+    if (swap->pendingCount == swap->batchPages)
+    {
+        flushSwap(swap);
+    }
+}
+
+// Take a page back out of the writeback buffer; its contents were never written, so it stays dirty
+bool swapReclaimPending(SwapDevice *swap, Page *entry)
+{
+    for (size_t i = 0; i < swap->pendingCount; i++)
+    {
+        if (swap->pending[i] == entry)
+        {
+            swap->pending[i] = swap->pending[--swap->pendingCount];
+            entry->swapSlot = SWAP_NO_SLOT;
+            entry->dirty = true;
+            swap->stats.pendingHits++;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Read a faulting page and the readahead pages after it, which sit in the slots following its own
+bool swapReadPages(SwapDevice *swap, Page **entries, size_t count)
+{
+    size_t slot = (size_t)entries[0]->swapSlot;
+    bool success = swapTransfer(swap, slot, count, false);
+
+    // A file-backed slot must hold the page it was written for
+    for (size_t i = 0; success && swap->file && i < count; i++)
+    {
+        SwapStamp stamp;
+        memcpy(&stamp, swap->buffer + i * swap->pageSize, sizeof(stamp));
+        if (stamp.processId != entries[i]->processId || stamp.vpage != entries[i]->id)
+        {
+            swap->stats.ioErrors++;
+            success = false;
+        }
+    }
+
+    swap->stats.pagesIn++;
+    swap->stats.readaheadPages += count - 1;
+    return success;
+}
+
+// Forget a page's copy on the device (or in the writeback buffer) once it is unmapped or rewritten
+void swapReleaseSlot(SwapDevice *swap, Page *entry)
+{
+    if (entry->swapSlot == SWAP_SLOT_PENDING)
+    {
+        for (size_t i = 0; i < swap->pendingCount; i++)
+        {
+            if (swap->pending[i] == entry)
+            {
+                swap->pending[i] = swap->pending[--swap->pendingCount];
+                break;
+            }
+        }
+    }
+    else if (entry->swapSlot >= 0)
+    {
+        setSlotUsed(swap, (size_t)entry->swapSlot, false);
+    }
+    entry->swapSlot = SWAP_NO_SLOT;
+}
+
+// Latency below which the given share of operations completed (upper bound of its histogram bucket)
+uint64_t swapLatencyPercentile(const SwapLatency *latency, double percentile)
+{
+    size_t target = (size_t)(percentile * latency->operations);
+    size_t seen = 0;
+    for (int bucket = 0; bucket < SWAP_LATENCY_BUCKETS; bucket++)
+    {
+        seen += latency->buckets[bucket];
+        if (seen > target || seen == latency->operations)
+        {
+            uint64_t bound = ((uint64_t)2 << bucket) - 1;
+            return bound < latency->maxNs ? bound : latency->maxNs;
+        }
+    }
+    return latency->maxNs;
+}
+
+static void printSwapLatency(const char *direction, const SwapLatency *latency)
+{
+    char logMsg[200];
+    sprintf(logMsg, "%s: %zu operations, avg %.0f ns, p50 <= %llu ns, p99 <= %llu ns, max %llu ns",
+            direction, latency->operations, latency->operations ? (double)latency->totalNs / latency->operations : 0.0,
+            (unsigned long long)swapLatencyPercentile(latency, 0.50), (unsigned long long)swapLatencyPercentile(latency, 0.99),
+            (unsigned long long)latency->maxNs);
+    info(logMsg);
+}
+
+// Print swap traffic, batching and readahead effectiveness, and the I/O latency distributions
+void printSwapStats(SwapDevice *swap)
+{
+    if (!swap)
+        return;
+
+    SwapStats *stats = &swap->stats;
+
+    char logMsg[200];
+    sprintf(logMsg, "======== Swap (%s) ========", swap->file ? "file-backed" : "simulated");
+    info(logMsg);
+
+    sprintf(logMsg, "Slots used: %zu of %zu, Writeback buffer: %zu pages",
+            swap->slotCount - swap->freeSlots, swap->slotCount, swap->pendingCount);
+    info(logMsg);
+
+    sprintf(logMsg, "Pages out: %zu in %zu batches (%.1f pages per write), Pages in: %zu, Buffer hits: %zu, Discarded: %zu",
+            stats->pagesOut, stats->writeBatches,
+            stats->outLatency.operations ? (double)stats->pagesOut / stats->outLatency.operations : 0.0,
+            stats->pagesIn, stats->pendingHits, stats->discarded);
+    info(logMsg);
+
+    sprintf(logMsg, "Readahead: %zu pages, %zu used (%.2f%%), I/O errors: %zu",
+            stats->readaheadPages, stats->readaheadHits,
+            stats->readaheadPages ? (double)stats->readaheadHits / stats->readaheadPages * 100 : 0.0, stats->ioErrors);
+    info(logMsg);
+
+    printSwapLatency("Swap-out latency", &stats->outLatency);
+    printSwapLatency("Swap-in latency", &stats->inLatency);
+}
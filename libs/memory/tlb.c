@@ -0,0 +1,223 @@
+#include "../../include/memory/tlb.h"
+#include "../../include/log/logger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// First entry of the set a virtual page maps to
+static TlbEntry *tlbSet(Tlb *tlb, size_t vpage)
+{
+    return &tlb->entries[(vpage % (size_t)tlb->sets) * tlb->ways];
+}
+
+// xorshift32 step for random replacement
+static unsigned int tlbRandom(Tlb *tlb)
+{
+    unsigned int x = tlb->randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    tlb->randomState = x;
+    return x;
+}
+
+// Drop every entry, as an untagged TLB must on an address-space switch
+static void tlbFlush(Tlb *tlb)
+{
+    for (int i = 0; i < tlb->entryCount; i++)
+    {
+        tlb->entries[i].valid = false;
+    }
+    tlb->stats.flushes++;
+}
+
+// Create a TLB of entryCount entries split into sets of the given number of ways
+Tlb *createTlb(int entryCount, int ways, TlbReplacement replacement, bool useAsid, unsigned long missPenalty)
+{
+    if (entryCount <= 0 || ways <= 0 || entryCount % ways != 0)
+    {
+        char errMsg[100];
+        sprintf(errMsg, "Cannot create TLB: %d entries do not divide into %d-way sets", entryCount, ways);
+        error(errMsg);
+        return NULL;
+    }
+
+    Tlb *tlb = (Tlb *)malloc(sizeof(Tlb));
+    TlbEntry *entries = (TlbEntry *)calloc(entryCount, sizeof(TlbEntry));
+    if (!tlb || !entries)
+    {
+        error("Failed to allocate memory for TLB");
+        free(tlb);
+        free(entries);
+        return NULL;
+    }
+
+    tlb->entryCount = entryCount;
+    tlb->ways = ways;
+    tlb->sets = entryCount / ways;
+    tlb->replacement = replacement;
+    tlb->useAsid = useAsid;
+    tlb->currentAsid = -1;
+    tlb->missPenalty = missPenalty;
+    tlb->clock = 0;
+    tlb->randomState = 0x9E3779B9u;
+    tlb->entries = entries;
+    memset(&tlb->stats, 0, sizeof(tlb->stats));
+
+    char logMsg[150];
+    sprintf(logMsg, "Created TLB: %d entries, %d-way (%d sets), %s replacement, %s, %lu-cycle miss penalty",
+            entryCount, ways, tlb->sets, replacement == TLB_REPLACE_LRU ? "LRU" : "random",
+            useAsid ? "ASID-tagged" : "untagged", missPenalty);
+    info(logMsg);
+
+    return tlb;
+}
+
+void destroyTlb(Tlb *tlb)
+{
+    if (!tlb)
+        return;
+
+    free(tlb->entries);
+    free(tlb);
+}
+
+// Look up a translation and the page table entry behind it; misses are charged the miss penalty
+bool tlbLookup(Tlb *tlb, int asid, size_t vpage, size_t *frameNumber, struct Page **pageEntry)
+{
+    if (!tlb->useAsid && asid != tlb->currentAsid && tlb->currentAsid >= 0)
+    {
+        tlbFlush(tlb);
+    }
+    tlb->currentAsid = asid;
+    tlb->stats.lookups++;
+
+    TlbEntry *set = tlbSet(tlb, vpage);
+    for (int way = 0; way < tlb->ways; way++)
+    {
+        TlbEntry *entry = &set[way];
+        if (entry->valid && entry->vpage == vpage && entry->asid == asid)
+        {
+            entry->lastUsed = ++tlb->clock;
+            *frameNumber = entry->frameNumber;
+            *pageEntry = entry->pageEntry;
+            tlb->stats.hits++;
+            return true;
+        }
+    }
+
+    tlb->stats.misses++;
+    tlb->stats.missCycles += tlb->missPenalty;
+    return false;
+}
+
+// Install a translation after a page table walk, replacing an entry in the set if it is full
+void tlbInsert(Tlb *tlb, int asid, size_t vpage, size_t frameNumber, struct Page *pageEntry)
+{
+    TlbEntry *set = tlbSet(tlb, vpage);
+    TlbEntry *victim = NULL;
+
+    for (int way = 0; way < tlb->ways && !victim; way++)
+    {
+        if (!set[way].valid || (set[way].vpage == vpage && set[way].asid == asid))
+        {
+            victim = &set[way];
+        }
+    }
+
+    if (!victim)
+    {
+        if (tlb->replacement == TLB_REPLACE_RANDOM)
+        {
+            victim = &set[tlbRandom(tlb) % (unsigned int)tlb->ways];
+        }
+        else
+        {
+            victim = &set[0];
+            for (int way = 1; way < tlb->ways; way++)
+            {
+                if (set[way].lastUsed < victim->lastUsed)
+                {
+                    victim = &set[way];
+                }
+            }
+        }
+        tlb->stats.evictions++;
+    }
+
+    victim->valid = true;
+    victim->asid = asid;
+    victim->vpage = vpage;
+    victim->frameNumber = frameNumber;
+    victim->pageEntry = pageEntry;
+    victim->lastUsed = ++tlb->clock;
+}
+
+// Invalidate one page's translation (the page was evicted or unmapped)
+int tlbInvalidatePage(Tlb *tlb, int asid, size_t vpage)
+{
+    tlb->stats.shootdowns++;
+
+    TlbEntry *set = tlbSet(tlb, vpage);
+    for (int way = 0; way < tlb->ways; way++)
+    {
+        if (set[way].valid && set[way].vpage == vpage && set[way].asid == asid)
+        {
+            set[way].valid = false;
+            tlb->stats.entriesShotDown++;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// Invalidate every translation of an address space (the process released its pages)
+int tlbInvalidateAsid(Tlb *tlb, int asid)
+{
+    tlb->stats.shootdowns++;
+
+    int removed = 0;
+    for (int i = 0; i < tlb->entryCount; i++)
+    {
+        if (tlb->entries[i].valid && tlb->entries[i].asid == asid)
+        {
+            tlb->entries[i].valid = false;
+            removed++;
+        }
+    }
+
+    tlb->stats.entriesShotDown += removed;
+    return removed;
+}
+
+double tlbHitRate(const Tlb *tlb)
+{
+    return tlb->stats.lookups > 0 ? (double)tlb->stats.hits / tlb->stats.lookups : 0.0;
+}
+
+// Print hit rate, translation cost and shootdown counts
+void printTlbStats(Tlb *tlb)
+{
+    if (!tlb)
+        return;
+
+    TlbStats *stats = &tlb->stats;
+    unsigned long totalCycles = stats->lookups * TLB_HIT_CYCLES + stats->missCycles;
+
+    char logMsg[200];
+    sprintf(logMsg, "======== TLB (%d entries, %d-way) ========", tlb->entryCount, tlb->ways);
+    info(logMsg);
+
+    sprintf(logMsg, "Lookups: %zu, Hits: %zu, Misses: %zu (%.2f%% hit rate), Evictions: %zu",
+            stats->lookups, stats->hits, stats->misses, tlbHitRate(tlb) * 100, stats->evictions);
+    info(logMsg);
+
+    sprintf(logMsg, "Translation cost: %lu cycles (%lu in miss penalties), %.2f cycles per lookup",
+            totalCycles, stats->missCycles, stats->lookups > 0 ? (double)totalCycles / stats->lookups : 0.0);
+    info(logMsg);
+
+    sprintf(logMsg, "Shootdowns: %zu (%zu entries invalidated), Context-switch flushes: %zu",
+            stats->shootdowns, stats->entriesShotDown, stats->flushes);
+    info(logMsg);
+}
@@ -0,0 +1,474 @@
+#include "../../include/memory/trace.h"
+#include "../../include/platform/sync.h"
+#include "../../include/log/logger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// Create (truncate) a trace file and write its header
+TraceWriter *openTraceWriter(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        char errMsg[150];
+        sprintf(errMsg, "Cannot open trace file for writing: %s", path);
+        error(errMsg);
+        return NULL;
+    }
+
+    TraceWriter *writer = (TraceWriter *)malloc(sizeof(TraceWriter));
+    if (!writer)
+    {
+        error("Failed to allocate memory for trace writer");
+        fclose(file);
+        return NULL;
+    }
+
+    fprintf(file, "%s\n", TRACE_FORMAT_HEADER);
+    writer->file = file;
+    writer->startNs = platform_monotonic_ns();
+    writer->events = 0;
+
+    return writer;
+}
+
+void closeTraceWriter(TraceWriter *writer)
+{
+    if (!writer)
+        return;
+
+    fclose(writer->file);
+    free(writer);
+}
+
+// Append one event, stamped with the time since the writer was opened
+void traceRecord(TraceWriter *writer, TraceEventType type, int processId, size_t value, bool isWrite, const char *name)
+{
+    unsigned long timestamp = (unsigned long)((platform_monotonic_ns() - writer->startNs) / 1000);
+
+    switch (type)
+    {
+    case TRACE_CREATE:
+        fprintf(writer->file, "%lu C %d %zu %s\n", timestamp, processId, value, name && *name ? name : "process");
+        break;
+
+    case TRACE_ALLOCATE:
+        fprintf(writer->file, "%lu A %d %zu\n", timestamp, processId, value);
+        break;
+
+    case TRACE_TERMINATE:
+        fprintf(writer->file, "%lu T %d\n", timestamp, processId);
+        break;
+
+    case TRACE_ACCESS:
+        fprintf(writer->file, "%lu X %d %zu %c\n", timestamp, processId, value, isWrite ? 'W' : 'R');
+        break;
+
+    case TRACE_FORK:
+        fprintf(writer->file, "%lu F %d %zu\n", timestamp, processId, value);
+        break;
+    }
+
+    writer->events++;
+}
+
+// Append an allocate event for pages mapped at a virtual address
+void traceRecordAllocateAt(TraceWriter *writer, int processId, size_t size, size_t virtualAddress)
+{
+    unsigned long timestamp = (unsigned long)((platform_monotonic_ns() - writer->startNs) / 1000);
+    fprintf(writer->file, "%lu A %d %zu %zu\n", timestamp, processId, size, virtualAddress);
+    writer->events++;
+}
+
+// Open a trace file, checking its format header
+TraceReader *openTraceReader(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        char errMsg[150];
+        sprintf(errMsg, "Cannot open trace file: %s", path);
+        error(errMsg);
+        return NULL;
+    }
+
+    char header[64];
+    if (!fgets(header, sizeof(header), file) || strncmp(header, TRACE_FORMAT_HEADER, strlen(TRACE_FORMAT_HEADER)) != 0)
+    {
+        char errMsg[150];
+        sprintf(errMsg, "Not a version 1 trace file: %s", path);
+        error(errMsg);
+        fclose(file);
+        return NULL;
+    }
+
+    TraceReader *reader = (TraceReader *)malloc(sizeof(TraceReader));
+    if (!reader)
+    {
+        error("Failed to allocate memory for trace reader");
+        fclose(file);
+        return NULL;
+    }
+
+    reader->file = file;
+    reader->line = 1;
+    return reader;
+}
+
+// Read the next event, skipping comments and reporting malformed lines; false at end of file
+bool traceNext(TraceReader *reader, TraceEvent *event)
+{
+    char line[256];
+    while (fgets(line, sizeof(line), reader->file))
+    {
+        reader->line++;
+        if (line[0] == '#' || line[0] == '\n')
+        {
+            continue;
+        }
+
+        char code;
+        char access = 'R';
+        int consumed = 0;
+        bool valid = sscanf(line, "%lu %c %d%n", &event->timestamp, &code, &event->processId, &consumed) == 3;
+
+        event->value = 0;
+        event->address = TRACE_NO_ADDRESS;
+        event->name[0] = '\0';
+        const char *args = line + consumed;
+        switch (valid ? code : '?')
+        {
+        case 'C':
+            event->type = TRACE_CREATE;
+            valid = sscanf(args, "%zu %31s", &event->value, event->name) == 2;
+            break;
+
+        case 'A':
+            event->type = TRACE_ALLOCATE;
+            valid = sscanf(args, "%zu %zu", &event->value, &event->address) >= 1;
+            break;
+
+        case 'T':
+            event->type = TRACE_TERMINATE;
+            break;
+
+        case 'X':
+            event->type = TRACE_ACCESS;
+            valid = sscanf(args, "%zu %c", &event->value, &access) == 2 && (access == 'R' || access == 'W');
+            break;
+
+        case 'F':
+            event->type = TRACE_FORK;
+            valid = sscanf(args, "%zu", &event->value) == 1;
+            break;
+
+        default:
+            valid = false;
+        }
+        event->isWrite = access == 'W';
+
+        if (valid)
+        {
+            return true;
+        }
+
+        char warnMsg[100];
+        sprintf(warnMsg, "Skipping malformed trace line %zu", reader->line);
+        warn(warnMsg);
+    }
+
+    return false;
+}
+
+void closeTraceReader(TraceReader *reader)
+{
+    if (!reader)
+        return;
+
+    fclose(reader->file);
+    free(reader);
+}
+
+static int compareLatency(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// A recorded process during replay; the map is indexed by the recorded id's table slot
+typedef struct
+{
+    int recordedId; // Full recorded id, so references from a recycled slot's earlier generation miss
+    int processId;  // Id in the replaying manager (-1: not running)
+} ReplayProcess;
+
+// Grow the recorded-to-replayed process map so it covers slot
+static bool growProcessMap(ReplayProcess **processMap, size_t *capacity, int slot)
+{
+    size_t newCapacity = *capacity ? *capacity : 64;
+    while (newCapacity <= (size_t)slot)
+    {
+        newCapacity *= 2;
+    }
+
+    ReplayProcess *newMap = (ReplayProcess *)realloc(*processMap, newCapacity * sizeof(ReplayProcess));
+    if (!newMap)
+    {
+        error("Failed to allocate memory for replay process map");
+        return false;
+    }
+
+    for (size_t i = *capacity; i < newCapacity; i++)
+    {
+        newMap[i].recordedId = -1;
+        newMap[i].processId = -1;
+    }
+    *processMap = newMap;
+    *capacity = newCapacity;
+    return true;
+}
+
+// Run one event against the manager, keeping the recorded process's map entry in step (parent is the
+// forking process's entry for a fork); returns success
+static bool replayEvent(MemoryManager *manager, const TraceEvent *event, ReplayProcess *process, const ReplayProcess *parent,
+                        uint64_t *elapsedNs)
+{
+    int processId = process->processId;
+    bool success = false;
+    uint64_t start = platform_monotonic_ns();
+
+    switch (event->type)
+    {
+    case TRACE_CREATE:
+        processId = createProcess(manager, event->name, event->value);
+        success = processId >= 0;
+        break;
+
+    case TRACE_ALLOCATE:
+        // Pages go where they were recorded, or past the current mapping; everything else gets another segment
+        if ((manager->strategy == PAGING || manager->strategy == HYBRID) && event->address != TRACE_NO_ADDRESS)
+        {
+            success = allocatePagesAt(manager, processId, event->address, event->value);
+        }
+        else if (manager->strategy == PAGING)
+        {
+            success = allocatePages(manager, processId, event->value);
+        }
+        else
+        {
+            success = allocateSegment(manager, processId, "heap", event->value);
+        }
+        break;
+
+    case TRACE_TERMINATE:
+        success = terminateProcess(manager, processId);
+        break;
+
+    case TRACE_ACCESS:
+    {
+        size_t physicalAddress;
+        success = translateAddress(manager, processId, event->value, event->isWrite, &physicalAddress);
+        break;
+    }
+
+    case TRACE_FORK:
+        processId = forkProcess(manager, parent->processId);
+        success = processId >= 0;
+        break;
+    }
+
+    *elapsedNs = platform_monotonic_ns() - start;
+
+    if (event->type == TRACE_CREATE || event->type == TRACE_FORK)
+    {
+        process->recordedId = event->processId;
+        process->processId = processId;
+    }
+    else if (event->type == TRACE_TERMINATE)
+    {
+        process->processId = -1;
+    }
+
+    return success;
+}
+
+void initReplayMeter(ReplayMeter *meter, size_t sampleInterval)
+{
+    memset(meter, 0, sizeof(ReplayMeter));
+    meter->sampleInterval = sampleInterval;
+}
+
+// Add one timed operation
+bool replayMeterRecord(ReplayMeter *meter, uint64_t elapsedNs, bool success)
+{
+    if (meter->latencyCount == meter->latencyCapacity)
+    {
+        size_t newCapacity = meter->latencyCapacity ? meter->latencyCapacity * 2 : 1024;
+        uint64_t *grown = (uint64_t *)realloc(meter->latencies, newCapacity * sizeof(uint64_t));
+        if (!grown)
+        {
+            error("Failed to allocate memory for replay latencies");
+            return false;
+        }
+        meter->latencies = grown;
+        meter->latencyCapacity = newCapacity;
+    }
+
+    meter->latencies[meter->latencyCount++] = elapsedNs;
+    meter->totalNs += elapsedNs;
+    if (!success)
+    {
+        meter->result.failed++;
+    }
+    return true;
+}
+
+// Count a finished event, sampling the manager's fragmentation every sampleInterval events
+bool replayMeterEvent(ReplayMeter *meter, MemoryManager *manager, unsigned long timestamp)
+{
+    ReplayResult *result = &meter->result;
+    result->events++;
+    if (meter->sampleInterval == 0 || result->events % meter->sampleInterval != 0)
+    {
+        return true;
+    }
+
+    if (result->sampleCount == meter->sampleCapacity)
+    {
+        size_t newCapacity = meter->sampleCapacity ? meter->sampleCapacity * 2 : 64;
+        ReplaySample *grown = (ReplaySample *)realloc(result->samples, newCapacity * sizeof(ReplaySample));
+        if (!grown)
+        {
+            error("Failed to allocate memory for replay samples");
+            return false;
+        }
+        result->samples = grown;
+        meter->sampleCapacity = newCapacity;
+    }
+
+    FragmentationStats stats = getFragmentationStats(manager);
+    ReplaySample *sample = &result->samples[result->sampleCount++];
+    sample->event = result->events;
+    sample->timestamp = timestamp;
+    sample->usedMemory = manager->usedMemory;
+    sample->externalFragmentation = stats.externalFragmentation;
+    sample->internalFragmentation = stats.internalFragmentation;
+    return true;
+}
+
+// Compute throughput and latency percentiles, releasing the latency buffer
+ReplayResult finishReplayMeter(ReplayMeter *meter)
+{
+    ReplayResult *result = &meter->result;
+    result->elapsedSeconds = meter->totalNs / 1e9;
+    result->opsPerSecond = meter->totalNs > 0 ? meter->latencyCount / result->elapsedSeconds : 0.0;
+    if (meter->latencyCount > 0)
+    {
+        qsort(meter->latencies, meter->latencyCount, sizeof(uint64_t), compareLatency);
+        const double percentiles[] = {0.50, 0.90, 0.99, 0.999, 1.0};
+        for (int i = 0; i < 5; i++)
+        {
+            result->latencyNs[i] = (double)meter->latencies[(size_t)(percentiles[i] * (meter->latencyCount - 1))];
+        }
+    }
+
+    free(meter->latencies);
+    meter->latencies = NULL;
+    return *result;
+}
+
+// Replay a trace against a manager as fast as possible, timing each operation
+ReplayResult replayTrace(MemoryManager *manager, const char *path, size_t sampleInterval)
+{
+    ReplayMeter meter;
+    initReplayMeter(&meter, sampleInterval);
+
+    TraceReader *reader = openTraceReader(path);
+    if (!reader)
+    {
+        return meter.result;
+    }
+
+    ReplayProcess *processMap = NULL;
+    size_t mapCapacity = 0;
+    bool ok = true;
+
+    // Logging would dominate the timings, so the manager runs silently
+    int savedOutput = log_output;
+    log_output = LOG_TO_NONE;
+
+    TraceEvent event;
+    while (ok && traceNext(reader, &event))
+    {
+        int slot = event.processId >= 0 ? PROCESS_SLOT(event.processId) : -1;
+        bool mapped = slot >= 0 && ((size_t)slot < mapCapacity || growProcessMap(&processMap, &mapCapacity, slot));
+        ReplayProcess *process = mapped ? &processMap[slot] : NULL;
+        int processId = mapped && process->recordedId == event.processId ? process->processId : -1;
+        Process *proc = processId >= 0 ? getProcess(manager, processId) : NULL;
+
+        // A fork runs against its parent, found by the recorded parent id
+        ReplayProcess *parent = NULL;
+        if (event.type == TRACE_FORK)
+        {
+            int parentSlot = PROCESS_SLOT((int)event.value);
+            parent = (size_t)parentSlot < mapCapacity && processMap[parentSlot].recordedId == (int)event.value ? &processMap[parentSlot] : NULL;
+            proc = parent && parent->processId >= 0 ? getProcess(manager, parent->processId) : NULL;
+        }
+
+        // Events for processes that never started, and accesses where the strategy has no page table, cannot run
+        if (!mapped || (event.type != TRACE_CREATE && !proc) || (event.type == TRACE_ACCESS && !proc->pageTable))
+        {
+            meter.result.skipped++;
+        }
+        else
+        {
+            uint64_t elapsed;
+            bool success = replayEvent(manager, &event, process, parent, &elapsed);
+            ok = replayMeterRecord(&meter, elapsed, success);
+        }
+
+        ok = ok && replayMeterEvent(&meter, manager, event.timestamp);
+    }
+
+    log_output = savedOutput;
+    closeTraceReader(reader);
+    free(processMap);
+
+    return finishReplayMeter(&meter);
+}
+
+// Print throughput, latency percentiles and the fragmentation samples of a replay
+void printReplayResult(const ReplayResult *result)
+{
+    char logMsg[200];
+    info("======== Trace Replay ========");
+
+    sprintf(logMsg, "Events: %zu (failed: %zu, skipped: %zu), %.3f s in the manager, %.0f ops/sec",
+            result->events, result->failed, result->skipped, result->elapsedSeconds, result->opsPerSecond);
+    info(logMsg);
+
+    sprintf(logMsg, "Latency (ns): p50 %.0f, p90 %.0f, p99 %.0f, p99.9 %.0f, max %.0f",
+            result->latencyNs[0], result->latencyNs[1], result->latencyNs[2], result->latencyNs[3], result->latencyNs[4]);
+    info(logMsg);
+
+    if (result->sampleCount == 0)
+        return;
+
+    info("Fragmentation over time (event, trace time us, used bytes, external %, internal %):");
+    for (size_t i = 0; i < result->sampleCount; i++)
+    {
+        const ReplaySample *sample = &result->samples[i];
+        sprintf(logMsg, "  %zu, %lu, %zu, %.2f, %.2f", sample->event, sample->timestamp, sample->usedMemory,
+                sample->externalFragmentation * 100, sample->internalFragmentation * 100);
+        info(logMsg);
+    }
+}
+
+void freeReplayResult(ReplayResult *result)
+{
+    free(result->samples);
+    result->samples = NULL;
+    result->sampleCount = 0;
+}
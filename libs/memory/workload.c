@@ -0,0 +1,271 @@
+#include "../../include/memory/workload.h"
+#include "../../include/platform/sync.h"
+#include "../../include/log/logger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#define WORKLOAD_PI 3.14159265358979323846
+#define WORKLOAD_MAX_SAMPLE 9007199254740992.0 // 2^53: exact as a double and safe to cast to size_t and uint64_t
+
+// A live generated process, keyed by the tick it terminates at
+typedef struct
+{
+    uint64_t expiry;
+    int processId;
+} WorkloadProcess;
+
+// Seed through a splitmix64 step so nearby seeds give unrelated streams
+void seedWorkloadRandom(WorkloadRandom *random, uint64_t seed)
+{
+    uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    random->state = (z ^ (z >> 31)) | 1; // xorshift state must be non-zero
+}
+
+// Uniform double in [0, 1) from an xorshift64* step
+double workloadUniform(WorkloadRandom *random)
+{
+    uint64_t x = random->state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    random->state = x;
+    return ((x * 0x2545F4914F6CDD1Dull) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Draw one value from a distribution (never negative, and capped so it always converts to an integer)
+double sampleDistribution(WorkloadRandom *random, const Distribution *distribution)
+{
+    double u = workloadUniform(random);
+    double value = 0.0;
+
+    switch (distribution->type)
+    {
+    case DIST_FIXED:
+        value = distribution->a;
+        break;
+
+    case DIST_UNIFORM:
+        value = distribution->a + (distribution->b - distribution->a) * u;
+        break;
+
+    case DIST_EXPONENTIAL:
+        value = -distribution->a * log(1.0 - u);
+        break;
+
+    case DIST_PARETO:
+        value = distribution->a / pow(1.0 - u, 1.0 / distribution->b);
+        break;
+
+    case DIST_BIMODAL:
+    {
+        // Pick a mode, then spread around it with a Box-Muller normal
+        double mean = u < distribution->c ? distribution->b : distribution->a;
+        double normal = sqrt(-2.0 * log(1.0 - workloadUniform(random))) * cos(2.0 * WORKLOAD_PI * workloadUniform(random));
+        value = mean * (1.0 + 0.1 * normal);
+        break;
+    }
+    }
+
+    // NaN fails the comparison and becomes 0 as well
+    return value > 0.0 ? fmin(value, WORKLOAD_MAX_SAMPLE) : 0.0;
+}
+
+const char *distributionName(DistributionType type)
+{
+    switch (type)
+    {
+    case DIST_FIXED:
+        return "fixed";
+    case DIST_UNIFORM:
+        return "uniform";
+    case DIST_EXPONENTIAL:
+        return "exponential";
+    case DIST_PARETO:
+        return "pareto";
+    case DIST_BIMODAL:
+        return "bimodal";
+    }
+    return "unknown";
+}
+
+// Parameters a distribution can be sampled with: finite, positive means, scales and shapes, an ordered
+// uniform range and a bimodal probability in [0, 1]
+static bool distributionValid(const Distribution *distribution)
+{
+    double a = distribution->a, b = distribution->b, c = distribution->c;
+    if (!isfinite(a) || !isfinite(b) || !isfinite(c))
+    {
+        return false;
+    }
+
+    switch (distribution->type)
+    {
+    case DIST_FIXED:
+        return a >= 0.0;
+    case DIST_UNIFORM:
+        return a >= 0.0 && a <= b;
+    case DIST_EXPONENTIAL:
+        return a > 0.0;
+    case DIST_PARETO:
+        return a > 0.0 && b > 0.0;
+    case DIST_BIMODAL:
+        return a > 0.0 && b > 0.0 && c >= 0.0 && c <= 1.0;
+    }
+    return false;
+}
+
+// Parse "name:a[:b[:c]]", e.g. "exponential:4096", "pareto:512:1.5" or "bimodal:256:65536:0.1"
+bool parseDistribution(const char *spec, Distribution *distribution)
+{
+    const DistributionType types[] = {DIST_FIXED, DIST_UNIFORM, DIST_EXPONENTIAL, DIST_PARETO, DIST_BIMODAL};
+    const int parameters[] = {1, 2, 1, 2, 3};
+
+    char name[16];
+    double a = 0.0, b = 0.0, c = 0.0;
+    int fields = sscanf(spec, "%15[a-z]:%lf:%lf:%lf", name, &a, &b, &c);
+
+    for (int i = 0; i < 5; i++)
+    {
+        if (fields >= 1 && strcmp(name, distributionName(types[i])) == 0 && fields - 1 == parameters[i])
+        {
+            distribution->type = types[i];
+            distribution->a = a;
+            distribution->b = b;
+            distribution->c = c;
+            if (!distributionValid(distribution))
+            {
+                break;
+            }
+            return true;
+        }
+    }
+
+    char errMsg[150];
+    sprintf(errMsg, "Invalid distribution '%s' (fixed:v, uniform:min:max, exponential:mean, pareto:scale:shape, bimodal:a:b:p)", spec);
+    error(errMsg);
+    return false;
+}
+
+// Restore the heap property upwards from index
+static void workloadHeapSiftUp(WorkloadProcess *heap, size_t index)
+{
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (heap[parent].expiry <= heap[index].expiry)
+            break;
+
+        WorkloadProcess swap = heap[parent];
+        heap[parent] = heap[index];
+        heap[index] = swap;
+        index = parent;
+    }
+}
+
+// Restore the heap property downwards from the root
+static void workloadHeapSiftDown(WorkloadProcess *heap, size_t count)
+{
+    size_t index = 0;
+    for (;;)
+    {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < count && heap[left].expiry < heap[smallest].expiry)
+            smallest = left;
+        if (right < count && heap[right].expiry < heap[smallest].expiry)
+            smallest = right;
+        if (smallest == index)
+            break;
+
+        WorkloadProcess swap = heap[smallest];
+        heap[smallest] = heap[index];
+        heap[index] = swap;
+        index = smallest;
+    }
+}
+
+// Generate creates and terminates on the fly, so only live processes are ever held in memory
+ReplayResult runWorkload(MemoryManager *manager, const WorkloadConfig *config)
+{
+    ReplayMeter meter;
+    initReplayMeter(&meter, config->sampleInterval);
+
+    if (!distributionValid(&config->size) || !distributionValid(&config->lifetime))
+    {
+        error("Invalid workload distribution parameters");
+        return finishReplayMeter(&meter);
+    }
+
+    WorkloadRandom random;
+    seedWorkloadRandom(&random, config->seed);
+
+    WorkloadProcess *live = NULL; // Min-heap on expiry
+    size_t liveCount = 0;
+    size_t liveCapacity = 0;
+    bool ok = true;
+
+    // Logging would dominate the timings, so the manager runs silently
+    int savedOutput = log_output;
+    log_output = LOG_TO_NONE;
+
+    for (uint64_t tick = 0; ok && meter.result.events < config->events; tick++)
+    {
+        // Terminate every process whose lifetime has run out
+        while (ok && liveCount > 0 && live[0].expiry <= tick && meter.result.events < config->events)
+        {
+            int processId = live[0].processId;
+            live[0] = live[--liveCount];
+            workloadHeapSiftDown(live, liveCount);
+
+            uint64_t start = platform_monotonic_ns();
+            bool success = terminateProcess(manager, processId);
+            ok = replayMeterRecord(&meter, platform_monotonic_ns() - start, success) &&
+                 replayMeterEvent(&meter, manager, (unsigned long)tick);
+        }
+
+        if (!ok || meter.result.events >= config->events)
+            break;
+
+        // One arrival per tick
+        size_t size = (size_t)sampleDistribution(&random, &config->size);
+        uint64_t lifetime = (uint64_t)llround(sampleDistribution(&random, &config->lifetime));
+        size = size > 0 ? size : 1;
+        lifetime = lifetime > 0 ? lifetime : 1;
+
+        uint64_t start = platform_monotonic_ns();
+        int processId = createProcess(manager, "generated", size);
+        uint64_t elapsed = platform_monotonic_ns() - start;
+
+        if (processId >= 0)
+        {
+            if (liveCount == liveCapacity)
+            {
+                size_t newCapacity = liveCapacity ? liveCapacity * 2 : 256;
+                WorkloadProcess *grown = (WorkloadProcess *)realloc(live, newCapacity * sizeof(WorkloadProcess));
+                if (!grown)
+                {
+                    error("Failed to allocate memory for generated processes");
+                    break;
+                }
+                live = grown;
+                liveCapacity = newCapacity;
+            }
+
+            live[liveCount].expiry = tick + lifetime;
+            live[liveCount].processId = processId;
+            workloadHeapSiftUp(live, liveCount++);
+        }
+
+        ok = replayMeterRecord(&meter, elapsed, processId >= 0) && replayMeterEvent(&meter, manager, (unsigned long)tick);
+    }
+
+    log_output = savedOutput;
+    free(live);
+
+    return finishReplayMeter(&meter);
+}
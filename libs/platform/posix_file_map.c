@@ -0,0 +1,89 @@
+#ifndef _WIN32
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../../include/platform/file_map.h"
+#include "../../include/log/logger.h"
+
+struct MappedFile
+{
+    void *data;
+    size_t size;
+};
+
+MappedFile *map_file(const char *path)
+{
+    MappedFile *file = (MappedFile *)malloc(sizeof(MappedFile));
+    if (file == NULL)
+    {
+        error("Failed to allocate memory for mapped file");
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+    {
+        char errorMsg[350];
+        sprintf(errorMsg, "Could not open %.256s for mapping.", path);
+        error(errorMsg);
+        free(file);
+        return NULL;
+    }
+
+    struct stat sb;
+    if (fstat(fd, &sb) == -1 || sb.st_size == 0)
+    {
+        char errorMsg[350];
+        sprintf(errorMsg, "Could not map %.256s: the file is empty or its size is unknown.", path);
+        error(errorMsg);
+        close(fd);
+        free(file);
+        return NULL;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    void *data = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        char errorMsg[350];
+        sprintf(errorMsg, "Could not map %.256s.", path);
+        error(errorMsg);
+        free(file);
+        return NULL;
+    }
+
+    file->data = data;
+    file->size = (size_t)sb.st_size;
+
+    return file;
+}
+
+const void *mapped_file_data(MappedFile *file)
+{
+    return file ? file->data : NULL;
+}
+
+size_t mapped_file_size(MappedFile *file)
+{
+    return file ? file->size : 0;
+}
+
+bool unmap_file(MappedFile *file)
+{
+    if (file == NULL)
+    {
+        return 0;
+    }
+
+    bool result = munmap(file->data, file->size) == 0;
+    free(file);
+
+    return result;
+}
+
+#endif // !_WIN32
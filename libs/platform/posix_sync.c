@@ -9,6 +9,7 @@
 #include <unistd.h>
 #include <termios.h>
 #include <sys/time.h>
+#include <time.h>
 #include "../../include/platform/sync.h"
 #include "../../include/log/logger.h"
 
@@ -36,8 +37,8 @@ MutexHandle *create_mutex(const char *name)
         return NULL;
     }
 
-    handle->name = strdup(name);
-    if (handle->name == NULL)
+    handle->name = name ? strdup(name) : NULL;
+    if (name && handle->name == NULL)
     {
         free(handle);
         error("Failed to allocate memory for mutex name");
@@ -95,6 +96,16 @@ bool lock_mutex(MutexHandle *handle)
     return pthread_mutex_lock(&handle->mutex) == 0;
 }
 
+bool try_lock_mutex(MutexHandle *handle)
+{
+    if (handle == NULL || !handle->initialized)
+    {
+        return 0;
+    }
+
+    return pthread_mutex_trylock(&handle->mutex) == 0;
+}
+
 bool unlock_mutex(MutexHandle *handle)
 {
     if (handle == NULL || !handle->initialized)
@@ -268,6 +279,13 @@ void platform_sleep(unsigned int milliseconds)
     usleep(milliseconds * 1000); // usleep takes microseconds
 }
 
+uint64_t platform_monotonic_ns()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
 // For non-blocking keyboard input on POSIX systems
 // Variables to keep track of terminal state
 static struct termios orig_term_attr;
@@ -0,0 +1,69 @@
+#ifndef _WIN32
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../../include/platform/thread.h"
+#include "../../include/log/logger.h"
+
+struct ThreadHandle
+{
+    pthread_t thread;
+    ThreadFunction function;
+    void *arg;
+};
+
+// pthread entry points return a value; ThreadFunction does not
+static void *thread_start(void *arg)
+{
+    ThreadHandle *handle = (ThreadHandle *)arg;
+    handle->function(handle->arg);
+    return NULL;
+}
+
+ThreadHandle *create_thread(ThreadFunction function, void *arg)
+{
+    ThreadHandle *handle = (ThreadHandle *)malloc(sizeof(ThreadHandle));
+    if (handle == NULL)
+    {
+        error("Failed to allocate memory for thread handle");
+        return NULL;
+    }
+
+    handle->function = function;
+    handle->arg = arg;
+
+    if (pthread_create(&handle->thread, NULL, thread_start, handle) != 0)
+    {
+        error("Failed to create thread");
+        free(handle);
+        return NULL;
+    }
+
+    return handle;
+}
+
+bool join_thread(ThreadHandle *handle)
+{
+    if (handle == NULL)
+    {
+        return 0;
+    }
+
+    bool result = pthread_join(handle->thread, NULL) == 0;
+    free(handle);
+    return result;
+}
+
+int get_cpu_count()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+
+long atomic_increment(volatile long *value)
+{
+    return __sync_add_and_fetch(value, 1);
+}
+
+#endif // !_WIN32
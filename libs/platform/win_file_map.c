@@ -0,0 +1,105 @@
+#ifdef _WIN32
+
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../include/platform/file_map.h"
+#include "../../include/log/logger.h"
+
+struct MappedFile
+{
+    HANDLE file;
+    HANDLE mapping;
+    void *data;
+    size_t size;
+};
+
+MappedFile *map_file(const char *path)
+{
+    MappedFile *file = (MappedFile *)malloc(sizeof(MappedFile));
+    if (file == NULL)
+    {
+        error("Failed to allocate memory for mapped file");
+        return NULL;
+    }
+
+    file->file = CreateFile(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file->file == INVALID_HANDLE_VALUE)
+    {
+        char errorMsg[100];
+        sprintf(errorMsg, "Could not open file for mapping (%lu).", GetLastError());
+        error(errorMsg);
+        free(file);
+        return NULL;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file->file, &size) || size.QuadPart == 0)
+    {
+        error("Could not map file: the file is empty or its size is unknown.");
+        CloseHandle(file->file);
+        free(file);
+        return NULL;
+    }
+
+    file->mapping = CreateFileMapping(
+        file->file,    // File to map
+        NULL,          // Default security
+        PAGE_READONLY, // Read-only access
+        0,             // Max size (high-order DWORD): the whole file
+        0,             // Max size (low-order DWORD)
+        NULL           // Unnamed
+    );
+
+    if (file->mapping == NULL)
+    {
+        char errorMsg[100];
+        sprintf(errorMsg, "Could not create file mapping object (%lu).", GetLastError());
+        error(errorMsg);
+        CloseHandle(file->file);
+        free(file);
+        return NULL;
+    }
+
+    file->data = MapViewOfFile(file->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (file->data == NULL)
+    {
+        char errorMsg[100];
+        sprintf(errorMsg, "Could not map view of file (%lu).", GetLastError());
+        error(errorMsg);
+        CloseHandle(file->mapping);
+        CloseHandle(file->file);
+        free(file);
+        return NULL;
+    }
+    file->size = (size_t)size.QuadPart;
+
+    return file;
+}
+
+const void *mapped_file_data(MappedFile *file)
+{
+    return file ? file->data : NULL;
+}
+
+size_t mapped_file_size(MappedFile *file)
+{
+    return file ? file->size : 0;
+}
+
+bool unmap_file(MappedFile *file)
+{
+    if (file == NULL)
+    {
+        return 0;
+    }
+
+    bool result = UnmapViewOfFile(file->data) != 0;
+    CloseHandle(file->mapping);
+    CloseHandle(file->file);
+    free(file);
+
+    return result;
+}
+
+#endif // _WIN32
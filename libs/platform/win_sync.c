@@ -83,6 +83,17 @@ bool lock_mutex(MutexHandle *handle)
     return result == WAIT_OBJECT_0;
 }
 
+bool try_lock_mutex(MutexHandle *handle)
+{
+    if (handle == NULL || handle->handle == NULL)
+    {
+        return 0;
+    }
+
+    DWORD result = WaitForSingleObject(handle->handle, 0);
+    return result == WAIT_OBJECT_0;
+}
+
 bool unlock_mutex(MutexHandle *handle)
 {
     if (handle == NULL || handle->handle == NULL)
@@ -200,6 +211,15 @@ void platform_sleep(unsigned int milliseconds)
     Sleep(milliseconds);
 }
 
+uint64_t platform_monotonic_ns()
+{
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000ull +
+           (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000ull / frequency.QuadPart;
+}
+
 // Platform-independent keyboard input functions
 int getch()
 {
@@ -0,0 +1,74 @@
+#ifdef _WIN32
+
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../include/platform/thread.h"
+#include "../../include/log/logger.h"
+
+struct ThreadHandle
+{
+    HANDLE handle;
+    ThreadFunction function;
+    void *arg;
+};
+
+// Win32 entry points return a DWORD; ThreadFunction does not
+static DWORD WINAPI thread_start(LPVOID arg)
+{
+    ThreadHandle *handle = (ThreadHandle *)arg;
+    handle->function(handle->arg);
+    return 0;
+}
+
+ThreadHandle *create_thread(ThreadFunction function, void *arg)
+{
+    ThreadHandle *handle = (ThreadHandle *)malloc(sizeof(ThreadHandle));
+    if (handle == NULL)
+    {
+        error("Failed to allocate memory for thread handle");
+        return NULL;
+    }
+
+    handle->function = function;
+    handle->arg = arg;
+
+    handle->handle = CreateThread(NULL, 0, thread_start, handle, 0, NULL);
+    if (handle->handle == NULL)
+    {
+        char errorMsg[100];
+        sprintf(errorMsg, "Could not create thread (%lu).", GetLastError());
+        error(errorMsg);
+        free(handle);
+        return NULL;
+    }
+
+    return handle;
+}
+
+bool join_thread(ThreadHandle *handle)
+{
+    if (handle == NULL)
+    {
+        return 0;
+    }
+
+    bool result = WaitForSingleObject(handle->handle, INFINITE) == WAIT_OBJECT_0;
+    CloseHandle(handle->handle);
+    free(handle);
+    return result;
+}
+
+int get_cpu_count()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+}
+
+long atomic_increment(volatile long *value)
+{
+    return InterlockedIncrement(value);
+}
+
+#endif // _WIN32
@@ -3,14 +3,17 @@ echo Running Memory Management Simulator...
 echo.
 
 REM Default memory size: 1MB (1048576 bytes), Page size: 4KB (4096 bytes)
-REM Optional parameters: memory_size page_size
+REM Optional parameters: memory_size page_size placement
 REM Example: memory_simulator.bat 2097152 8192 - for 2MB memory with 8KB pages
+REM Placement: first | next | best | worst | segregated (default)
 
 cd %~dp0\..
 set MEM_SIZE=1048576
 set PAGE_SIZE=4096
+set PLACEMENT=segregated
 
 if not "%~1"=="" set MEM_SIZE=%~1
 if not "%~2"=="" set PAGE_SIZE=%~2
+if not "%~3"=="" set PLACEMENT=%~3
 
-build\bin\memory_simulator.exe %MEM_SIZE% %PAGE_SIZE%
+build\bin\memory_simulator.exe %MEM_SIZE% %PAGE_SIZE% %PLACEMENT%
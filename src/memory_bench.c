@@ -0,0 +1,327 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../include/memory/memory_manager.h"
+#include "../include/memory/trace.h"
+#include "../include/memory/workload.h"
+#include "../include/platform/sync.h"
+#include "../include/log/logger.h"
+
+#define BENCH_DEFAULT_ITERATIONS 5000 // Timed calls per operation and configuration
+#define BENCH_BATCH 128               // Allocations held at once before they are freed again
+#define BENCH_PAGE_SIZE 4096
+#define BENCH_FILL_RATIO 0.6          // Share of memory (blocks and frames, not requested bytes) filled before holes are punched
+#define BENCH_SEED 42
+#define BENCH_MAX_PROCESSES 100000
+
+// Operations timed by the suite
+typedef enum
+{
+    BENCH_ALLOCATE_SEGMENT,
+    BENCH_DEALLOCATE_SEGMENTS,
+    BENCH_ALLOCATE_PAGES,
+    BENCH_DEALLOCATE_PAGES,
+    BENCH_CALCULATE_FRAGMENTATION,
+    BENCH_ALLOCATE_SEGMENTS_BATCH, // Latency per batch call; ops, failures and throughput per request
+    BENCH_ALLOCATE_PAGES_BATCH,
+    BENCH_OPERATION_COUNT
+} BenchOperation;
+
+typedef enum
+{
+    BENCH_CSV,
+    BENCH_JSON
+} BenchFormat;
+
+static const char *operationNames[] = {"allocateSegment", "deallocateSegments", "allocatePages", "deallocatePages", "calculateFragmentation",
+                                       "allocateSegmentsBatch", "allocatePagesBatch"};
+static const MemoryStrategy strategies[] = {SEGMENTATION, PAGING, HYBRID, BUDDY, TLSF};
+static const char *strategyNames[] = {"segmentation", "paging", "hybrid", "buddy", "tlsf"};
+static const size_t memorySizes[] = {4194304, 33554432, 268435456}; // 4MB, 32MB, 256MB
+static const double fragmentationLevels[] = {0.0, 0.25, 0.5, 0.75};   // Share of filler processes terminated
+
+static int rowsWritten = 0;
+
+bool operationApplies(MemoryStrategy strategy, BenchOperation operation);
+void fragmentManager(MemoryManager *manager, WorkloadRandom *random, double level);
+void runConfiguration(BenchFormat format, int strategyIndex, size_t totalMemory, double level, size_t iterations);
+void writeRow(BenchFormat format, const char *strategy, size_t totalMemory, double level, double externalFragmentation,
+              BenchOperation operation, const ReplayResult *result);
+
+int main(int argc, char *argv[])
+{
+    // Only the results go to stdout
+    init_logger(LOG_TO_NONE, LOG_VERBOSITY_INFO);
+
+    // memory_bench [csv|json] [iterations] [strategy|all]
+    BenchFormat format = argc > 1 && strcmp(argv[1], "json") == 0 ? BENCH_JSON : BENCH_CSV;
+    size_t iterations = argc > 2 && atol(argv[2]) > 0 ? (size_t)atol(argv[2]) : BENCH_DEFAULT_ITERATIONS;
+    const char *only = argc > 3 ? argv[3] : "all";
+
+    if (argc > 1 && strcmp(argv[1], "csv") != 0 && strcmp(argv[1], "json") != 0)
+    {
+        fprintf(stderr, "Usage: memory_bench [csv|json] [iterations] [segmentation|paging|hybrid|buddy|tlsf|all]\n");
+        return 1;
+    }
+
+    if (format == BENCH_CSV)
+    {
+        printf("strategy,total_memory,fragmentation_level,external_fragmentation,operation,ops,failed,ops_per_sec,p50_ns,p99_ns,p999_ns,max_ns\n");
+    }
+    else
+    {
+        printf("[\n");
+    }
+
+    for (int s = 0; s < 5; s++)
+    {
+        if (strcmp(only, "all") != 0 && strcmp(only, strategyNames[s]) != 0)
+            continue;
+
+        for (size_t m = 0; m < sizeof(memorySizes) / sizeof(memorySizes[0]); m++)
+        {
+            for (size_t f = 0; f < sizeof(fragmentationLevels) / sizeof(fragmentationLevels[0]); f++)
+            {
+                runConfiguration(format, s, memorySizes[m], fragmentationLevels[f], iterations);
+            }
+        }
+    }
+
+    if (format == BENCH_JSON)
+    {
+        printf("\n]\n");
+    }
+
+    close_logger();
+    return 0;
+}
+
+// Segment operations need segmentation, buddy, TLSF or hybrid; page operations need paging or hybrid
+bool operationApplies(MemoryStrategy strategy, BenchOperation operation)
+{
+    switch (operation)
+    {
+    case BENCH_ALLOCATE_SEGMENT:
+    case BENCH_DEALLOCATE_SEGMENTS:
+    case BENCH_ALLOCATE_SEGMENTS_BATCH:
+        return strategy != PAGING;
+    case BENCH_ALLOCATE_PAGES:
+    case BENCH_DEALLOCATE_PAGES:
+    case BENCH_ALLOCATE_PAGES_BATCH:
+        return strategy == PAGING || strategy == HYBRID;
+    default:
+        return true;
+    }
+}
+
+// Fill the manager with filler processes, then terminate a random share of them to leave holes
+void fragmentManager(MemoryManager *manager, WorkloadRandom *random, double level)
+{
+    Distribution size = {DIST_EXPONENTIAL, manager->totalMemory / 256.0, 0.0, 0.0};
+    int *fillers = (int *)malloc(BENCH_MAX_PROCESSES * sizeof(int));
+    int fillerCount = 0;
+
+    while (fillerCount < BENCH_MAX_PROCESSES && manager->freeMemory > manager->totalMemory * (1.0 - BENCH_FILL_RATIO))
+    {
+        int processId = createProcess(manager, "filler", (size_t)sampleDistribution(random, &size) + 1);
+        if (processId < 0)
+            break;
+        fillers[fillerCount++] = processId;
+    }
+
+    for (int i = 0; i < fillerCount; i++)
+    {
+        if (workloadUniform(random) < level)
+        {
+            terminateProcess(manager, fillers[i]);
+        }
+    }
+
+    free(fillers);
+}
+
+// Time every applicable operation against one strategy, memory size and fragmentation level
+void runConfiguration(BenchFormat format, int strategyIndex, size_t totalMemory, double level, size_t iterations)
+{
+    MemoryStrategy strategy = strategies[strategyIndex];
+    size_t pageSize = strategy == SEGMENTATION || strategy == TLSF ? 0 : BENCH_PAGE_SIZE;
+    MemoryManager *manager = createMemoryManager(strategy, totalMemory, pageSize, BENCH_MAX_PROCESSES, PLACEMENT_SEGREGATED_FIT);
+    if (!manager)
+    {
+        fprintf(stderr, "Failed to create %s manager of %zu bytes\n", strategyNames[strategyIndex], totalMemory);
+        return;
+    }
+
+    WorkloadRandom random;
+    seedWorkloadRandom(&random, BENCH_SEED);
+    fragmentManager(manager, &random, level);
+    double externalFragmentation = getFragmentationStats(manager).externalFragmentation;
+
+    ReplayMeter meters[BENCH_OPERATION_COUNT];
+    for (int op = 0; op < BENCH_OPERATION_COUNT; op++)
+    {
+        initReplayMeter(&meters[op], 0);
+    }
+
+    // Requests average 1/1024 of memory, so a batch takes about an eighth of it
+    Distribution size = {DIST_EXPONENTIAL, totalMemory / 1024.0, 0.0, 0.0};
+    int batch[BENCH_BATCH];
+    AllocationRequest requests[BENCH_BATCH];
+    bool satisfied[BENCH_BATCH];
+    size_t done = 0;
+
+    while (done < iterations)
+    {
+        int count = iterations - done < BENCH_BATCH ? (int)(iterations - done) : BENCH_BATCH;
+
+        // Untimed: a one-byte process per request, so only the allocation under test is measured
+        for (int i = 0; i < count; i++)
+        {
+            batch[i] = createProcess(manager, "bench", 1);
+        }
+
+        const BenchOperation allocations[] = {BENCH_ALLOCATE_SEGMENT, BENCH_ALLOCATE_PAGES};
+        for (int a = 0; a < 2; a++)
+        {
+            BenchOperation op = allocations[a];
+            if (!operationApplies(strategy, op))
+                continue;
+
+            for (int i = 0; i < count; i++)
+            {
+                size_t bytes = (size_t)sampleDistribution(&random, &size) + 1;
+                uint64_t start = platform_monotonic_ns();
+                bool success;
+                if (op == BENCH_ALLOCATE_SEGMENT)
+                {
+                    success = batch[i] >= 0 && allocateSegment(manager, batch[i], "bench", bytes);
+                }
+                else
+                {
+                    success = batch[i] >= 0 && allocatePages(manager, batch[i], bytes);
+                }
+                replayMeterRecord(&meters[op], platform_monotonic_ns() - start, success);
+                replayMeterEvent(&meters[op], manager, 0);
+            }
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            uint64_t start = platform_monotonic_ns();
+            calculateFragmentation(manager);
+            replayMeterRecord(&meters[BENCH_CALCULATE_FRAGMENTATION], platform_monotonic_ns() - start, true);
+            replayMeterEvent(&meters[BENCH_CALCULATE_FRAGMENTATION], manager, 0);
+        }
+
+        const BenchOperation deallocations[] = {BENCH_DEALLOCATE_SEGMENTS, BENCH_DEALLOCATE_PAGES};
+        for (int d = 0; d < 2; d++)
+        {
+            BenchOperation op = deallocations[d];
+            if (!operationApplies(strategy, op))
+                continue;
+
+            for (int i = 0; i < count; i++)
+            {
+                uint64_t start = platform_monotonic_ns();
+                if (batch[i] >= 0)
+                {
+                    if (op == BENCH_DEALLOCATE_SEGMENTS)
+                        deallocateSegments(manager, batch[i]);
+                    else
+                        deallocatePages(manager, batch[i]);
+                }
+                replayMeterRecord(&meters[op], platform_monotonic_ns() - start, batch[i] >= 0);
+                replayMeterEvent(&meters[op], manager, 0);
+            }
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            if (batch[i] >= 0)
+            {
+                terminateProcess(manager, batch[i]);
+            }
+        }
+
+        // The same number of requests through the batch entry points, on fresh one-byte processes as above. Each call
+        // is one latency sample, while every request counts as an event so failures and throughput stay per request
+        const BenchOperation batchAllocations[] = {BENCH_ALLOCATE_SEGMENTS_BATCH, BENCH_ALLOCATE_PAGES_BATCH};
+        for (int a = 0; a < 2; a++)
+        {
+            BenchOperation op = batchAllocations[a];
+            if (!operationApplies(strategy, op))
+                continue;
+
+            for (int i = 0; i < count; i++)
+            {
+                requests[i].processId = createProcess(manager, "bench", 1);
+                requests[i].size = (size_t)sampleDistribution(&random, &size) + 1;
+            }
+
+            uint64_t start = platform_monotonic_ns();
+            if (op == BENCH_ALLOCATE_SEGMENTS_BATCH)
+                allocateSegmentsBatch(manager, requests, count, "bench", satisfied);
+            else
+                allocatePagesBatch(manager, requests, count, satisfied);
+            replayMeterRecord(&meters[op], platform_monotonic_ns() - start, true);
+
+            for (int i = 0; i < count; i++)
+            {
+                if (!satisfied[i])
+                {
+                    meters[op].result.failed++;
+                }
+                replayMeterEvent(&meters[op], manager, 0);
+            }
+
+            for (int i = 0; i < count; i++)
+            {
+                if (requests[i].processId >= 0)
+                {
+                    terminateProcess(manager, requests[i].processId);
+                }
+            }
+        }
+        done += count;
+    }
+
+    for (int op = 0; op < BENCH_OPERATION_COUNT; op++)
+    {
+        ReplayResult result = finishReplayMeter(&meters[op]);
+        if (op == BENCH_ALLOCATE_SEGMENTS_BATCH || op == BENCH_ALLOCATE_PAGES_BATCH)
+        {
+            // The meter counts calls per second; batch rows report requests per second
+            result.opsPerSecond = result.elapsedSeconds > 0 ? result.events / result.elapsedSeconds : 0.0;
+        }
+        if (operationApplies(strategy, (BenchOperation)op))
+        {
+            writeRow(format, strategyNames[strategyIndex], totalMemory, level, externalFragmentation, (BenchOperation)op, &result);
+        }
+        freeReplayResult(&result);
+    }
+
+    destroyMemoryManager(manager);
+}
+
+// One result line: a CSV record, or a JSON object in the top-level array
+void writeRow(BenchFormat format, const char *strategy, size_t totalMemory, double level, double externalFragmentation,
+              BenchOperation operation, const ReplayResult *result)
+{
+    if (format == BENCH_CSV)
+    {
+        printf("%s,%zu,%.2f,%.4f,%s,%zu,%zu,%.0f,%.0f,%.0f,%.0f,%.0f\n",
+               strategy, totalMemory, level, externalFragmentation, operationNames[operation], result->events, result->failed,
+               result->opsPerSecond, result->latencyNs[0], result->latencyNs[2], result->latencyNs[3], result->latencyNs[4]);
+    }
+    else
+    {
+        printf("%s  {\"strategy\": \"%s\", \"total_memory\": %zu, \"fragmentation_level\": %.2f, \"external_fragmentation\": %.4f, "
+               "\"operation\": \"%s\", \"ops\": %zu, \"failed\": %zu, \"ops_per_sec\": %.0f, "
+               "\"p50_ns\": %.0f, \"p99_ns\": %.0f, \"p999_ns\": %.0f, \"max_ns\": %.0f}",
+               rowsWritten > 0 ? ",\n" : "", strategy, totalMemory, level, externalFragmentation, operationNames[operation],
+               result->events, result->failed, result->opsPerSecond,
+               result->latencyNs[0], result->latencyNs[2], result->latencyNs[3], result->latencyNs[4]);
+    }
+    rowsWritten++;
+}
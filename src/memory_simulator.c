@@ -3,16 +3,59 @@
 #include <string.h>
 #include <stdbool.h>
 #include "../include/memory/memory_manager.h"
+#include "../include/memory/slab_cache.h"
+#include "../include/memory/tlb.h"
+#include "../include/memory/swap.h"
+#include "../include/memory/analytics.h"
+#include "../include/memory/trace.h"
+#include "../include/memory/workload.h"
+#include "../include/memory/sharded_manager.h"
+#include "../include/platform/thread.h"
+#include "../include/platform/sync.h"
 #include "../include/log/logger.h"
 
 #define DEFAULT_TOTAL_MEMORY 1048576 // 1MB
 #define DEFAULT_PAGE_SIZE 4096       // 4KB
 #define MAX_PROCESSES 100
+#define DEMAND_PAGING_ACCESSES 20000
+#define DEMAND_PAGING_SEED 42
+#define TLB_DEMO_ENTRIES 64
+#define TLB_DEMO_WAYS 4
+#define TLB_DEMO_MISS_PENALTY 30 // Cycles for a page table walk
+#define SWAP_DEMO_FILE "memory_simulator.swap" // Scratch swap file, removed after the demo
+#define SWAP_DEMO_BATCH 16
+#define SWAP_DEMO_READAHEAD 4
+#define HUGE_PAGE_DEMO_FRAMES 16 // Base pages per huge page in the paging demo
+#define REPLAY_SAMPLE_INTERVAL 1000 // Events between fragmentation samples in replay mode
+#define REPLAY_MAX_PROCESSES 100000 // Live processes; the table grows as needed and recycles ids
+#define GENERATE_DEFAULT_EVENTS 1000000
+#define GENERATE_DEFAULT_SEED 42
+#define GENERATE_DEFAULT_SIZE "exponential:4096"
+#define GENERATE_DEFAULT_LIFETIME "exponential:100"
+#define SCALE_DEFAULT_OPS_PER_THREAD 200000
+#define SCALE_DEFAULT_TOTAL_MEMORY 67108864 // 64MB
+#define SCALE_MIN_THREADS 4 // Threads measured even on hosts with fewer cores, to show oversubscription
+#define SCALE_SEED 42
+
+// Set in record mode; every demo manager records into it
+static TraceWriter *traceRecorder = NULL;
 
 void displayMenu();
-void runSegmentationDemo(size_t totalMemory);
+PlacementPolicy parsePlacementPolicy(const char *name);
+bool parseMemoryStrategy(const char *name, MemoryStrategy *strategy);
+MemoryManager *createDemoManager(MemoryStrategy strategy, size_t totalMemory, size_t pageSize, PlacementPolicy placement);
+int runReplay(int argc, char *argv[]);
+int runGenerate(int argc, char *argv[]);
+int runRestore(int argc, char *argv[]);
+int runScale(int argc, char *argv[]);
+void runSegmentationDemo(size_t totalMemory, PlacementPolicy placement);
 void runPagingDemo(size_t totalMemory, size_t pageSize);
-void runHybridDemo(size_t totalMemory, size_t pageSize);
+void runHybridDemo(size_t totalMemory, size_t pageSize, PlacementPolicy placement);
+void runBuddyDemo(size_t totalMemory, size_t pageSize);
+void runSlabDemo(size_t totalMemory, size_t pageSize);
+void runTlsfDemo(size_t totalMemory);
+void runDemandPagingDemo(size_t totalMemory, size_t pageSize);
+void runTlbDemo(size_t totalMemory, size_t pageSize);
 
 int main(int argc, char *argv[])
 {
@@ -22,6 +65,51 @@ int main(int argc, char *argv[])
     info("==========================");
     info("This simulator demonstrates memory allocation using segmentation and paging");
 
+    // Headless mode: replay <trace> <strategy> [totalMemory] [pageSize] [placement] [sampleInterval]
+    if (argc > 1 && strcmp(argv[1], "replay") == 0)
+    {
+        int status = runReplay(argc, argv);
+        close_logger();
+        return status;
+    }
+
+    // Headless mode: generate <strategy> [events] [seed] [sizeDist] [lifetimeDist] [totalMemory] [pageSize] [placement] [sampleInterval] [snapshot]
+    if (argc > 1 && strcmp(argv[1], "generate") == 0)
+    {
+        int status = runGenerate(argc, argv);
+        close_logger();
+        return status;
+    }
+
+    // Headless mode: restore <snapshot>
+    if (argc > 1 && strcmp(argv[1], "restore") == 0)
+    {
+        int status = runRestore(argc, argv);
+        close_logger();
+        return status;
+    }
+
+    // Headless mode: scale <strategy> [maxThreads] [opsPerThread] [totalMemory] [pageSize] [placement]
+    if (argc > 1 && strcmp(argv[1], "scale") == 0)
+    {
+        int status = runScale(argc, argv);
+        close_logger();
+        return status;
+    }
+
+    // Record mode: record <trace> [totalMemory] [pageSize] [placement] runs the menu, tracing every demo
+    if (argc > 2 && strcmp(argv[1], "record") == 0)
+    {
+        traceRecorder = openTraceWriter(argv[2]);
+        if (!traceRecorder)
+        {
+            close_logger();
+            return 1;
+        }
+        argc -= 2;
+        argv += 2;
+    }
+
     size_t totalMemory = DEFAULT_TOTAL_MEMORY;
     size_t pageSize = DEFAULT_PAGE_SIZE;
 
@@ -44,8 +132,15 @@ int main(int argc, char *argv[])
         }
     }
 
-    char configMsg[100];
-    sprintf(configMsg, "Total Memory: %zu bytes, Page Size: %zu bytes", totalMemory, pageSize);
+    PlacementPolicy placement = PLACEMENT_SEGREGATED_FIT;
+    if (argc > 3)
+    {
+        placement = parsePlacementPolicy(argv[3]);
+    }
+
+    char configMsg[150];
+    sprintf(configMsg, "Total Memory: %zu bytes, Page Size: %zu bytes, Placement: %s",
+            totalMemory, pageSize, placementPolicyName(placement));
     info(configMsg);
 
     char choice;
@@ -60,7 +155,7 @@ int main(int argc, char *argv[])
         switch (choice)
         {
         case '1':
-            runSegmentationDemo(totalMemory);
+            runSegmentationDemo(totalMemory, placement);
             break;
 
         case '2':
@@ -68,10 +163,30 @@ int main(int argc, char *argv[])
             break;
 
         case '3':
-            runHybridDemo(totalMemory, pageSize);
+            runHybridDemo(totalMemory, pageSize, placement);
             break;
 
         case '4':
+            runBuddyDemo(totalMemory, pageSize);
+            break;
+
+        case '5':
+            runSlabDemo(totalMemory, pageSize);
+            break;
+
+        case '6':
+            runTlsfDemo(totalMemory);
+            break;
+
+        case '7':
+            runDemandPagingDemo(totalMemory, pageSize);
+            break;
+
+        case '8':
+            runTlbDemo(totalMemory, pageSize);
+            break;
+
+        case '9':
             info("Exiting Memory Management Simulator...");
             running = false;
             break;
@@ -81,6 +196,14 @@ int main(int argc, char *argv[])
         }
     }
 
+    if (traceRecorder)
+    {
+        char traceMsg[100];
+        sprintf(traceMsg, "Recorded %zu trace events", traceRecorder->events);
+        info(traceMsg);
+        closeTraceWriter(traceRecorder);
+    }
+
     close_logger();
     return 0;
 }
@@ -91,15 +214,222 @@ void displayMenu()
     info("1. Segmentation Demonstration");
     info("2. Paging Demonstration");
     info("3. Hybrid (Segmentation + Paging) Demonstration");
-    info("4. Exit");
+    info("4. Buddy System Demonstration");
+    info("5. Slab Cache Demonstration");
+    info("6. TLSF (Two-Level Segregated Fit) Demonstration");
+    info("7. Demand Paging Demonstration");
+    info("8. TLB Demonstration");
+    info("9. Exit");
+}
+
+// Map a command line placement name to a policy, defaulting to segregated fit
+PlacementPolicy parsePlacementPolicy(const char *name)
+{
+    if (strcmp(name, "first") == 0)
+        return PLACEMENT_FIRST_FIT;
+    if (strcmp(name, "next") == 0)
+        return PLACEMENT_NEXT_FIT;
+    if (strcmp(name, "best") == 0)
+        return PLACEMENT_BEST_FIT;
+    if (strcmp(name, "worst") == 0)
+        return PLACEMENT_WORST_FIT;
+    if (strcmp(name, "segregated") != 0)
+        warn("Unknown placement policy, using segregated fit");
+
+    return PLACEMENT_SEGREGATED_FIT;
+}
+
+// Map a command line strategy name to a strategy
+bool parseMemoryStrategy(const char *name, MemoryStrategy *strategy)
+{
+    const MemoryStrategy strategies[] = {SEGMENTATION, PAGING, HYBRID, BUDDY, TLSF};
+    const char *names[] = {"segmentation", "paging", "hybrid", "buddy", "tlsf"};
+    for (int i = 0; i < 5; i++)
+    {
+        if (strcmp(name, names[i]) == 0)
+        {
+            *strategy = strategies[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Create a manager for a demo, recording its workload when running in record mode
+MemoryManager *createDemoManager(MemoryStrategy strategy, size_t totalMemory, size_t pageSize, PlacementPolicy placement)
+{
+    MemoryManager *manager = createMemoryManager(strategy, totalMemory, pageSize, MAX_PROCESSES, placement);
+    if (manager)
+    {
+        manager->trace = traceRecorder;
+    }
+    return manager;
+}
+
+// Replay a recorded trace against one strategy without the menu, then report throughput and fragmentation
+int runReplay(int argc, char *argv[])
+{
+    MemoryStrategy strategy;
+    if (argc < 4 || !parseMemoryStrategy(argv[3], &strategy))
+    {
+        error("Usage: memory_simulator replay <trace> <segmentation|paging|hybrid|buddy|tlsf> [totalMemory] [pageSize] [placement] [sampleInterval]");
+        return 1;
+    }
+
+    size_t totalMemory = argc > 4 && atol(argv[4]) > 0 ? (size_t)atol(argv[4]) : DEFAULT_TOTAL_MEMORY;
+    size_t pageSize = argc > 5 && atol(argv[5]) > 0 ? (size_t)atol(argv[5]) : DEFAULT_PAGE_SIZE;
+    PlacementPolicy placement = argc > 6 ? parsePlacementPolicy(argv[6]) : PLACEMENT_SEGREGATED_FIT;
+    size_t sampleInterval = argc > 7 ? (size_t)atol(argv[7]) : REPLAY_SAMPLE_INTERVAL;
+
+    // Replayed traces can hold far more processes than the demos
+    MemoryManager *manager = createMemoryManager(strategy, totalMemory, strategy == SEGMENTATION || strategy == TLSF ? 0 : pageSize,
+                                                 REPLAY_MAX_PROCESSES, placement);
+    if (!manager)
+    {
+        error("Failed to create memory manager");
+        return 1;
+    }
+
+    char configMsg[200];
+    sprintf(configMsg, "Replaying %s against %s (Total Memory: %zu bytes, Page Size: %zu bytes, Placement: %s)",
+            argv[2], memoryStrategyName(strategy), totalMemory, pageSize, placementPolicyName(placement));
+    info(configMsg);
+
+    ReplayResult result = replayTrace(manager, argv[2], sampleInterval);
+    printReplayResult(&result);
+    calculateFragmentation(manager);
+
+    freeReplayResult(&result);
+    destroyMemoryManager(manager);
+    return 0;
+}
+
+// Stream a seeded synthetic workload into one strategy without the menu, then report throughput and fragmentation
+// and optionally checkpoint the warmed-up manager
+int runGenerate(int argc, char *argv[])
+{
+    MemoryStrategy strategy;
+    WorkloadConfig config;
+    if (argc < 3 || !parseMemoryStrategy(argv[2], &strategy) ||
+        !parseDistribution(argc > 5 ? argv[5] : GENERATE_DEFAULT_SIZE, &config.size) ||
+        !parseDistribution(argc > 6 ? argv[6] : GENERATE_DEFAULT_LIFETIME, &config.lifetime))
+    {
+        error("Usage: memory_simulator generate <segmentation|paging|hybrid|buddy|tlsf> [events] [seed] [sizeDist] [lifetimeDist] [totalMemory] [pageSize] [placement] [sampleInterval] [snapshot]");
+        return 1;
+    }
+
+    config.events = argc > 3 && atol(argv[3]) > 0 ? (size_t)atol(argv[3]) : GENERATE_DEFAULT_EVENTS;
+    config.seed = argc > 4 ? (uint64_t)strtoull(argv[4], NULL, 10) : GENERATE_DEFAULT_SEED;
+    size_t totalMemory = argc > 7 && atol(argv[7]) > 0 ? (size_t)atol(argv[7]) : DEFAULT_TOTAL_MEMORY;
+    size_t pageSize = argc > 8 && atol(argv[8]) > 0 ? (size_t)atol(argv[8]) : DEFAULT_PAGE_SIZE;
+    PlacementPolicy placement = argc > 9 ? parsePlacementPolicy(argv[9]) : PLACEMENT_SEGREGATED_FIT;
+    config.sampleInterval = argc > 10 ? (size_t)atol(argv[10]) : config.events / 20;
+
+    MemoryManager *manager = createMemoryManager(strategy, totalMemory, strategy == SEGMENTATION || strategy == TLSF ? 0 : pageSize,
+                                                 REPLAY_MAX_PROCESSES, placement);
+    if (!manager)
+    {
+        error("Failed to create memory manager");
+        return 1;
+    }
+
+    char configMsg[250];
+    sprintf(configMsg, "Generating %zu events (seed %llu, sizes %s, lifetimes %s) against %s (Total Memory: %zu bytes, Page Size: %zu bytes, Placement: %s)",
+            config.events, (unsigned long long)config.seed, distributionName(config.size.type), distributionName(config.lifetime.type),
+            memoryStrategyName(strategy), totalMemory, pageSize, placementPolicyName(placement));
+    info(configMsg);
+
+    ReplayResult result = runWorkload(manager, &config);
+    printReplayResult(&result);
+    calculateFragmentation(manager);
+
+    bool saved = argc > 11 ? saveMemoryManager(manager, argv[11]) : true;
+
+    freeReplayResult(&result);
+    destroyMemoryManager(manager);
+    return saved ? 0 : 1;
+}
+
+// Load a snapshot written by generate without the menu and report the restored state
+int runRestore(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        error("Usage: memory_simulator restore <snapshot>");
+        return 1;
+    }
+
+    uint64_t start = platform_monotonic_ns();
+    MemoryManager *manager = loadMemoryManager(argv[2]);
+    uint64_t elapsed = platform_monotonic_ns() - start;
+    if (!manager)
+    {
+        return 1;
+    }
+
+    char timeMsg[100];
+    sprintf(timeMsg, "Restored %d processes in %.2f ms", manager->processCount, elapsed / 1e6);
+    info(timeMsg);
+
+    printMemoryStats(manager);
+    calculateFragmentation(manager);
+
+    destroyMemoryManager(manager);
+    return 0;
+}
+
+// Measure how throughput scales with threads, behind one lock and with one shard per thread
+int runScale(int argc, char *argv[])
+{
+    MemoryStrategy strategy;
+    if (argc < 3 || !parseMemoryStrategy(argv[2], &strategy))
+    {
+        error("Usage: memory_simulator scale <segmentation|paging|hybrid|buddy|tlsf> [maxThreads] [opsPerThread] [totalMemory] [pageSize] [placement]");
+        return 1;
+    }
+
+    int cpuCount = get_cpu_count();
+    int maxThreads = argc > 3 && atoi(argv[3]) > 0 ? atoi(argv[3]) : (cpuCount > SCALE_MIN_THREADS ? cpuCount : SCALE_MIN_THREADS);
+    size_t opsPerThread = argc > 4 && atol(argv[4]) > 0 ? (size_t)atol(argv[4]) : SCALE_DEFAULT_OPS_PER_THREAD;
+    size_t totalMemory = argc > 5 && atol(argv[5]) > 0 ? (size_t)atol(argv[5]) : SCALE_DEFAULT_TOTAL_MEMORY;
+    size_t pageSize = argc > 6 && atol(argv[6]) > 0 ? (size_t)atol(argv[6]) : DEFAULT_PAGE_SIZE;
+    PlacementPolicy placement = argc > 7 ? parsePlacementPolicy(argv[7]) : PLACEMENT_SEGREGATED_FIT;
+    maxThreads = maxThreads < SHARDED_MAX_SHARDS ? maxThreads : SHARDED_MAX_SHARDS;
+    pageSize = strategy == SEGMENTATION || strategy == TLSF ? 0 : pageSize;
+
+    char logMsg[200];
+    sprintf(logMsg, "Scaling %s on %d CPUs: up to %d threads, %zu operations each (Total Memory: %zu bytes, Placement: %s)",
+            memoryStrategyName(strategy), cpuCount, maxThreads, opsPerThread, totalMemory, placementPolicyName(placement));
+    info(logMsg);
+
+    // Powers of two, then maxThreads itself
+    double baseline = 0.0;
+    for (int step = 1; step / 2 < maxThreads; step *= 2)
+    {
+        int threads = step < maxThreads ? step : maxThreads;
+        ShardedBenchmarkResult single = runShardedBenchmark(strategy, totalMemory, pageSize, placement, threads, 1, opsPerThread, SCALE_SEED);
+        ShardedBenchmarkResult sharded = runShardedBenchmark(strategy, totalMemory, pageSize, placement, threads, threads, opsPerThread, SCALE_SEED);
+        if (threads == 1)
+        {
+            baseline = single.opsPerSecond;
+        }
+
+        sprintf(logMsg, "%2d threads | 1 lock: %10.0f ops/sec (%5.1f%% contended) | %2d shards: %10.0f ops/sec (%5.1f%% contended), %.2fx one thread",
+                threads, single.opsPerSecond, single.contention * 100.0, sharded.shards, sharded.opsPerSecond,
+                sharded.contention * 100.0, baseline > 0.0 ? sharded.opsPerSecond / baseline : 0.0);
+        info(logMsg);
+    }
+
+    return 0;
 }
 
 // Run a demonstration using segmentation memory allocation
-void runSegmentationDemo(size_t totalMemory)
+void runSegmentationDemo(size_t totalMemory, PlacementPolicy placement)
 {
     info("\n=== Starting Segmentation Demonstration ===");
 
-    MemoryManager *manager = createMemoryManager(SEGMENTATION, totalMemory, 0, MAX_PROCESSES);
+    MemoryManager *manager = createDemoManager(SEGMENTATION, totalMemory, 0, placement);
     if (!manager)
     {
         error("Failed to create memory manager");
@@ -141,6 +471,7 @@ void runSegmentationDemo(size_t totalMemory)
     // Terminate a process in the middle to create fragmentation
     info("Terminating Process2 to create fragmentation...");
     terminateProcess(manager, processIds[1]);
+    processIds[1] = -1; // Terminated ids are stale and rejected from now on
 
     info("After terminating Process2:");
     printMemoryStats(manager);
@@ -165,6 +496,13 @@ void runSegmentationDemo(size_t totalMemory)
     visualizeMemoryGraphically(manager);
     calculateFragmentation(manager);
 
+    // Slide the remaining processes together so all free memory forms a single hole
+    info("\nCompacting memory...");
+    compactMemory(manager);
+    visualizeMemory(manager);
+    visualizeMemoryGraphically(manager);
+    calculateFragmentation(manager);
+
     // Cleanup
     info("\nCleaning up all processes...");
     for (int i = 0; i < 5; i++)
@@ -189,7 +527,7 @@ void runPagingDemo(size_t totalMemory, size_t pageSize)
 {
     info("\n=== Starting Paging Demonstration ===");
 
-    MemoryManager *manager = createMemoryManager(PAGING, totalMemory, pageSize, MAX_PROCESSES);
+    MemoryManager *manager = createDemoManager(PAGING, totalMemory, pageSize, PLACEMENT_SEGREGATED_FIT);
     if (!manager)
     {
         error("Failed to create memory manager");
@@ -233,6 +571,7 @@ void runPagingDemo(size_t totalMemory, size_t pageSize)
     // Terminate some processes
     info("\nTerminating Process2 (freeing its pages)...");
     terminateProcess(manager, processIds[1]);
+    processIds[1] = -1;
 
     info("\nAfter terminating Process2:");
     printMemoryStats(manager);
@@ -249,9 +588,26 @@ void runPagingDemo(size_t totalMemory, size_t pageSize)
     visualizeMemoryGraphically(manager);
     calculateFragmentation(manager);
 
+    // Sparse address space: one page far from Process1's existing mapping only adds one radix path
+    info("\nMapping one page for Process1 a billion pages into its address space...");
+    allocatePagesAt(manager, processIds[0], ((size_t)1 << 30) * pageSize, pageSize);
+    printMemoryStats(manager);
+
+    // Copy-on-write fork: the children map Process4's frames instead of copying them
+    info("\nForking Process4 twice (the children share its frames read-only)...");
+    processIds[4] = forkProcess(manager, processIds[3]);
+    processIds[5] = forkProcess(manager, processIds[3]);
+    printCowStats(manager);
+
+    info("\nWriting a page in the first child (copied on write) and reading one in the second (still shared)...");
+    accessPage(manager, processIds[4], 0, true);
+    accessPage(manager, processIds[5], 1, false);
+    printCowStats(manager);
+    printMemoryStats(manager);
+
     // Cleanup
     info("\nCleaning up all processes...");
-    for (int i = 0; i < 4; i++)
+    for (int i = 0; i < 6; i++)
     {
         if (processIds[i] >= 0)
         {
@@ -262,16 +618,42 @@ void runPagingDemo(size_t totalMemory, size_t pageSize)
     printMemoryStats(manager);
     visualizeMemory(manager);
 
+    // Mixed page sizes: large processes get huge pages while aligned free runs last
+    info("\nEnabling huge pages and scattering small processes across memory...");
+    enableHugePages(manager, pageSize * HUGE_PAGE_DEMO_FRAMES);
+
+    int smallIds[MAX_PROCESSES];
+    int smallCount = 0;
+    for (size_t frame = 0; frame + HUGE_PAGE_DEMO_FRAMES <= manager->totalPages / 2 && smallCount < MAX_PROCESSES / 2;
+         frame += HUGE_PAGE_DEMO_FRAMES / 2)
+    {
+        smallIds[smallCount++] = createProcess(manager, "Small", pageSize * HUGE_PAGE_DEMO_FRAMES / 2);
+    }
+    for (int i = 0; i < smallCount; i += 2)
+    {
+        terminateProcess(manager, smallIds[i]); // Leaves half-huge-page holes
+    }
+
+    info("\nCreating a large process (3.5 huge pages): aligned runs become huge pages, the rest base pages...");
+    int largeId = createProcess(manager, "Large", pageSize * HUGE_PAGE_DEMO_FRAMES * 7 / 2);
+    calculateFragmentation(manager);
+
+    terminateProcess(manager, largeId);
+    for (int i = 1; i < smallCount; i += 2)
+    {
+        terminateProcess(manager, smallIds[i]);
+    }
+
     destroyMemoryManager(manager);
     info("=== Paging Demonstration Completed ===\n");
 }
 
 // Run a demonstration using hybrid memory allocation (both segmentation and paging)
-void runHybridDemo(size_t totalMemory, size_t pageSize)
+void runHybridDemo(size_t totalMemory, size_t pageSize, PlacementPolicy placement)
 {
     info("\n=== Starting Hybrid (Segmentation + Paging) Demonstration ===");
 
-    MemoryManager *manager = createMemoryManager(HYBRID, totalMemory, pageSize, MAX_PROCESSES);
+    MemoryManager *manager = createDemoManager(HYBRID, totalMemory, pageSize, placement);
     if (!manager)
     {
         error("Failed to create memory manager");
@@ -320,6 +702,7 @@ void runHybridDemo(size_t totalMemory, size_t pageSize)
     info("\nTerminating processes to create both types of fragmentation...");
     info("Terminating LargeProc1 (frees segmentation space)");
     terminateProcess(manager, processIds[1]);
+    processIds[1] = -1;
     info("\nAfter terminating LargeProc1:");
     printMemoryStats(manager);
     visualizeMemory(manager);
@@ -327,6 +710,7 @@ void runHybridDemo(size_t totalMemory, size_t pageSize)
 
     info("\nTerminating SmallProc2 (frees paged space)");
     terminateProcess(manager, processIds[2]);
+    processIds[2] = -1;
     info("\nAfter terminating SmallProc2:");
     printMemoryStats(manager);
     visualizeMemory(manager);
@@ -366,3 +750,358 @@ void runHybridDemo(size_t totalMemory, size_t pageSize)
     destroyMemoryManager(manager);
     info("=== Hybrid Demonstration Completed ===\n");
 }
+
+// Run a demonstration using the binary buddy allocator
+void runBuddyDemo(size_t totalMemory, size_t pageSize)
+{
+    info("\n=== Starting Buddy System Demonstration ===");
+
+    MemoryManager *manager = createDemoManager(BUDDY, totalMemory, pageSize, PLACEMENT_FIRST_FIT);
+    if (!manager)
+    {
+        error("Failed to create memory manager");
+        return;
+    }
+
+    // Initial memory state
+    info("\nInitial memory state:");
+    printMemoryStats(manager);
+    visualizeMemory(manager);
+    visualizeMemoryGraphically(manager);
+
+    // Requests are rounded up to a power-of-two number of blocks
+    info("Creating processes whose sizes are not powers of two...");
+
+    int processIds[10];
+    processIds[0] = createProcess(manager, "Process1", totalMemory / 10);
+    info("\nAfter creating Process1 (10%% of memory, rounded up to a power-of-two block):");
+    printMemoryStats(manager);
+    visualizeMemory(manager);
+    visualizeMemoryGraphically(manager);
+
+    processIds[1] = createProcess(manager, "Process2", pageSize * 3);
+    info("\nAfter creating Process2 (3 blocks, rounded up to 4):");
+    printMemoryStats(manager);
+    visualizeMemory(manager);
+    visualizeMemoryGraphically(manager);
+
+    processIds[2] = createProcess(manager, "Process3", pageSize);
+    info("\nAfter creating Process3 (exactly 1 block):");
+    printMemoryStats(manager);
+    visualizeMemory(manager);
+    visualizeMemoryGraphically(manager);
+    calculateFragmentation(manager);
+
+    // Freeing blocks coalesces them with their buddies
+    info("\nTerminating Process2 (its block merges back with free buddies)...");
+    terminateProcess(manager, processIds[1]);
+    processIds[1] = -1;
+    printMemoryStats(manager);
+    visualizeMemory(manager);
+    visualizeMemoryGraphically(manager);
+
+    // Cleanup
+    info("\nCleaning up all processes...");
+    for (int i = 0; i < 3; i++)
+    {
+        if (processIds[i] >= 0 && i != 1)
+        {
+            terminateProcess(manager, processIds[i]);
+        }
+    }
+
+    info("\nFinal memory state after cleanup (all buddies coalesced):");
+    printMemoryStats(manager);
+    visualizeMemory(manager);
+    visualizeMemoryGraphically(manager);
+
+    destroyMemoryManager(manager);
+    info("=== Buddy System Demonstration Completed ===\n");
+}
+
+// Run a demonstration of slab object caches layered on paging
+void runSlabDemo(size_t totalMemory, size_t pageSize)
+{
+    info("\n=== Starting Slab Cache Demonstration ===");
+
+    MemoryManager *manager = createDemoManager(PAGING, totalMemory, pageSize, PLACEMENT_SEGREGATED_FIT);
+    if (!manager)
+    {
+        error("Failed to create memory manager");
+        return;
+    }
+
+    ObjectCache *cache = createCache(manager, 48);
+    if (!cache)
+    {
+        destroyMemoryManager(manager);
+        return;
+    }
+
+    // Many small same-size objects share page frames instead of taking one each
+    const int objectCount = 200;
+    size_t addresses[200];
+    int allocated = 0;
+
+    info("Allocating 200 objects of 48 bytes...");
+    for (int i = 0; i < objectCount; i++)
+    {
+        if (cacheAlloc(cache, &addresses[i]))
+        {
+            allocated++;
+        }
+    }
+
+    char logMsg[150];
+    sprintf(logMsg, "Allocated %d objects using %d page frames (page-granular allocation would use %d)",
+            allocated, cache->slabCount, allocated);
+    info(logMsg);
+    printCacheStats(cache);
+    printMemoryStats(manager);
+    visualizeMemoryGraphically(manager);
+
+    // Freeing every other object leaves partial slabs; freeing the rest empties them
+    info("\nFreeing every other object...");
+    for (int i = 0; i < allocated; i += 2)
+    {
+        cacheFree(cache, addresses[i]);
+    }
+    printCacheStats(cache);
+
+    info("\nFreeing the remaining objects and shrinking the cache...");
+    for (int i = 1; i < allocated; i += 2)
+    {
+        cacheFree(cache, addresses[i]);
+    }
+    size_t released = cacheShrink(cache);
+    sprintf(logMsg, "Released %zu empty slabs back to the page frame table", released);
+    info(logMsg);
+    printCacheStats(cache);
+    printMemoryStats(manager);
+
+    destroyCache(cache);
+    destroyMemoryManager(manager);
+    info("=== Slab Cache Demonstration Completed ===\n");
+}
+
+// Run a demonstration using the TLSF allocator
+void runTlsfDemo(size_t totalMemory)
+{
+    info("\n=== Starting TLSF Demonstration ===");
+
+    MemoryManager *manager = createDemoManager(TLSF, totalMemory, 0, PLACEMENT_SEGREGATED_FIT);
+    if (!manager)
+    {
+        error("Failed to create memory manager");
+        return;
+    }
+
+    info("\nInitial memory state:");
+    printMemoryStats(manager);
+    visualizeMemoryGraphically(manager);
+
+    // Every allocation and free is two bitmap lookups plus constant list work
+    info("Creating processes of assorted sizes...");
+
+    int processIds[10];
+    processIds[0] = createProcess(manager, "Process1", totalMemory / 10);
+    processIds[1] = createProcess(manager, "Process2", totalMemory / 5 + 3);
+    processIds[2] = createProcess(manager, "Process3", totalMemory / 8 + 5);
+    processIds[3] = createProcess(manager, "Process4", 100);
+
+    info("\nAfter creating four processes:");
+    printMemoryStats(manager);
+    visualizeMemory(manager);
+    visualizeMemoryGraphically(manager);
+
+    // Freed blocks merge with free physical neighbours immediately
+    info("\nTerminating Process2 and Process3 (their blocks merge into one free block)...");
+    terminateProcess(manager, processIds[1]);
+    terminateProcess(manager, processIds[2]);
+    printMemoryStats(manager);
+    visualizeMemory(manager);
+    visualizeMemoryGraphically(manager);
+
+    processIds[4] = createProcess(manager, "Process5", totalMemory / 4);
+    info("\nAfter creating Process5 in the merged hole:");
+    printMemoryStats(manager);
+    visualizeMemory(manager);
+
+    // Cleanup
+    info("\nCleaning up all processes...");
+    int liveIds[] = {processIds[0], processIds[3], processIds[4]};
+    for (int i = 0; i < 3; i++)
+    {
+        if (liveIds[i] >= 0)
+        {
+            terminateProcess(manager, liveIds[i]);
+        }
+    }
+
+    info("\nFinal memory state after cleanup:");
+    printMemoryStats(manager);
+    visualizeMemoryGraphically(manager);
+
+    destroyMemoryManager(manager);
+    info("=== TLSF Demonstration Completed ===\n");
+}
+
+void runDemandPagingDemo(size_t totalMemory, size_t pageSize)
+{
+    info("\n=== Starting Demand Paging Demonstration ===");
+
+    // Two processes whose combined virtual size is twice physical memory
+    size_t framesTotal = totalMemory / pageSize;
+    size_t hotPages = framesTotal / 4;
+
+    char configMsg[150];
+    sprintf(configMsg, "%zu frames; two processes of %zu pages each, with a hot set of %zu pages per process",
+            framesTotal, framesTotal, hotPages);
+    info(configMsg);
+
+    ReplacementPolicy policies[] = {REPLACEMENT_FIFO, REPLACEMENT_LRU, REPLACEMENT_CLOCK, REPLACEMENT_ARC};
+    for (int p = 0; p < 4; p++)
+    {
+        MemoryManager *manager = createDemoManager(PAGING, totalMemory, pageSize, PLACEMENT_FIRST_FIT);
+        if (!manager)
+        {
+            error("Failed to create memory manager");
+            return;
+        }
+
+        enableDemandPaging(manager, policies[p]);
+
+        // Every policy sees the same access stream, so its working sets and reuse distances are measured once
+        AccessAnalytics *analytics = p == 0 ? createAccessAnalytics(ANALYTICS_DEFAULT_WINDOW) : NULL;
+        manager->analytics = analytics;
+
+        int processIds[2];
+        processIds[0] = createProcess(manager, "Process1", totalMemory);
+        processIds[1] = createProcess(manager, "Process2", totalMemory);
+
+        // Mostly hot-set accesses, interrupted by occasional sequential scans that flush naive policies
+        srand(DEMAND_PAGING_SEED);
+        size_t scanPage = 0;
+        for (int i = 0; i < DEMAND_PAGING_ACCESSES; i++)
+        {
+            int pid = processIds[rand() % 2];
+            size_t vpage = (i / 500) % 4 == 3 ? scanPage++ % framesTotal : (size_t)rand() % hotPages;
+            accessPage(manager, pid, vpage, rand() % 4 == 0);
+        }
+
+        printPagingStats(manager);
+        printAccessAnalytics(analytics);
+
+        terminateProcess(manager, processIds[0]);
+        terminateProcess(manager, processIds[1]);
+        manager->analytics = NULL;
+        destroyMemoryManager(manager);
+        destroyAccessAnalytics(analytics);
+    }
+
+    // Thrashing: working sets around the size of physical memory, evicting to a swap file
+    info("\nSweeping working sets across the size of physical memory, with evicted pages written to swap...");
+    const int workingSetPercent[] = {50, 90, 110, 150};
+    for (int w = 0; w < 4; w++)
+    {
+        size_t workingSet = framesTotal * workingSetPercent[w] / 100;
+        MemoryManager *manager = createDemoManager(PAGING, totalMemory, pageSize, PLACEMENT_FIRST_FIT);
+        SwapDevice *swap = createSwapDevice(SWAP_DEMO_FILE, pageSize, framesTotal * 2, SWAP_DEMO_BATCH, SWAP_DEMO_READAHEAD);
+        if (!swap)
+        {
+            swap = createSwapDevice(NULL, pageSize, framesTotal * 2, SWAP_DEMO_BATCH, SWAP_DEMO_READAHEAD);
+        }
+        if (!manager || !swap)
+        {
+            error("Failed to create memory manager or swap device");
+            destroyMemoryManager(manager);
+            destroySwapDevice(swap);
+            return;
+        }
+
+        enableDemandPaging(manager, REPLACEMENT_LRU);
+        manager->swap = swap;
+        int processId = createProcess(manager, "Worker", workingSet * pageSize);
+
+        // Half sequential passes over the working set, half random touches; a quarter of them writes
+        srand(DEMAND_PAGING_SEED);
+        size_t cursor = 0;
+        for (int i = 0; i < DEMAND_PAGING_ACCESSES; i++)
+        {
+            size_t vpage = rand() % 2 ? cursor++ % workingSet : (size_t)rand() % workingSet;
+            accessPage(manager, processId, vpage, rand() % 4 == 0);
+        }
+
+        char resultMsg[150];
+        sprintf(resultMsg, "\nWorking set of %d%% of memory (%zu pages): %zu faults in %zu accesses (%.2f%%)",
+                workingSetPercent[w], workingSet, manager->pagingStats.faults, manager->pagingStats.accesses,
+                manager->pagingStats.accesses ? (double)manager->pagingStats.faults / manager->pagingStats.accesses * 100 : 0.0);
+        info(resultMsg);
+        flushSwap(swap);
+        printSwapStats(swap);
+
+        terminateProcess(manager, processId);
+        manager->swap = NULL;
+        destroyMemoryManager(manager);
+        destroySwapDevice(swap);
+    }
+    remove(SWAP_DEMO_FILE);
+
+    info("=== Demand Paging Demonstration Completed ===\n");
+}
+
+void runTlbDemo(size_t totalMemory, size_t pageSize)
+{
+    info("\n=== Starting TLB Demonstration ===");
+
+    // The same byte-address stream translated with growing page sizes
+    size_t pageSizes[] = {pageSize, pageSize * 4, pageSize * 16};
+    size_t processSize = totalMemory / 2;
+
+    for (int s = 0; s < 3; s++)
+    {
+        if (pageSizes[s] > processSize)
+        {
+            continue;
+        }
+
+        char configMsg[100];
+        sprintf(configMsg, "\nPage size: %zu bytes", pageSizes[s]);
+        info(configMsg);
+
+        MemoryManager *manager = createDemoManager(PAGING, totalMemory, pageSizes[s], PLACEMENT_FIRST_FIT);
+        Tlb *tlb = createTlb(TLB_DEMO_ENTRIES, TLB_DEMO_WAYS, TLB_REPLACE_LRU, true, TLB_DEMO_MISS_PENALTY);
+        if (!manager || !tlb)
+        {
+            error("Failed to create memory manager or TLB");
+            destroyMemoryManager(manager);
+            destroyTlb(tlb);
+            return;
+        }
+        manager->tlb = tlb;
+
+        int processIds[2];
+        processIds[0] = createProcess(manager, "Process1", processSize / 2);
+        processIds[1] = createProcess(manager, "Process2", processSize / 2);
+
+        // Mostly accesses near a slowly drifting hot spot, some anywhere in the process
+        srand(DEMAND_PAGING_SEED);
+        for (int i = 0; i < DEMAND_PAGING_ACCESSES; i++)
+        {
+            size_t hotSpot = (size_t)i * 16 % (processSize / 2);
+            size_t address = rand() % 10 ? (hotSpot + rand() % 65536) % (processSize / 2) : (size_t)rand() % (processSize / 2);
+            size_t physicalAddress;
+            translateAddress(manager, processIds[i % 2], address, false, &physicalAddress);
+        }
+
+        // Terminating the processes shoots down their translations
+        terminateProcess(manager, processIds[0]);
+        terminateProcess(manager, processIds[1]);
+        printTlbStats(tlb);
+
+        destroyMemoryManager(manager);
+        destroyTlb(tlb);
+    }
+
+    info("=== TLB Demonstration Completed ===\n");
+}